@@ -0,0 +1,46 @@
+#version 430 core
+
+// Ray cast sphere: exact silhouette, normal and depth, lit like fragment_shader.glsl
+out vec4 FragColor;
+
+in vec3 QuadPos;
+in vec3 CenterView;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform float radius;
+
+uniform vec3 lightDir;
+uniform vec3 viewPos;
+uniform vec3 lightColor;
+uniform vec3 objectColor;
+
+void main() {
+    // Ray from the camera (origin of the view space) through the quad
+    vec3 dir = normalize(QuadPos);
+    float b = dot(dir, CenterView);
+    float disc = b * b - dot(CenterView, CenterView) + radius * radius;
+    if (disc < 0.0) discard;
+
+    vec3 hitView = (b - sqrt(disc)) * dir;
+
+    vec4 clip = projection * vec4(hitView, 1.0);
+    gl_FragDepth = 0.5 * clip.z / clip.w + 0.5;
+
+    // Back to world space, the view matrix is a rigid transform
+    mat3 invRot = transpose(mat3(view));
+    vec3 norm = invRot * ((hitView - CenterView) / radius);
+    vec3 fragPos = invRot * (hitView - vec3(view[3]));
+
+    vec3 ambient = 0.2 * lightColor;
+
+    float diff = max(dot(norm, -lightDir), 0.0);
+    vec3 diffuse = diff * lightColor * 0.8;
+
+    vec3 viewDir = normalize(viewPos - fragPos);
+    vec3 reflectDir = reflect(lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 8);
+    vec3 specular = 0.3 * spec * lightColor;
+
+    FragColor = vec4(ambient * objectColor + diffuse * objectColor + specular, 1.0);
+}
@@ -0,0 +1,25 @@
+#version 430 core
+
+// Camera facing quad around each sphere, drawn as an instanced triangle strip
+layout(location = 3) in vec3 aCenter;
+
+out vec3 QuadPos;    // view space
+out vec3 CenterView; // view space
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform float radius;
+
+void main()
+{
+    const vec2 corners[4] = vec2[](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(-1.0, 1.0), vec2(1.0, 1.0));
+
+    CenterView = vec3(view * vec4(aCenter, 1.0));
+
+    // In perspective the silhouette is larger than the radius: d / sqrt(d^2 - r^2)
+    float d2 = dot(CenterView, CenterView);
+    float scale = 1.1 * inversesqrt(max(1.0 - radius * radius / d2, 0.01));
+
+    QuadPos = CenterView + vec3(corners[gl_VertexID] * radius * scale, 0.0);
+    gl_Position = projection * vec4(QuadPos, 1.0);
+}
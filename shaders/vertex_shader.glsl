@@ -2,6 +2,7 @@
 
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
+layout(location = 3) in vec3 aOffset; // per instance, (0, 0, 0) when the attribute is not enabled
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -12,7 +13,7 @@ uniform mat4 projection;
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    FragPos = vec3(model * vec4(aPos, 1.0)) + aOffset;
     Normal = mat3(transpose(inverse(model))) * aNormal;
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
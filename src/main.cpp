@@ -9,6 +9,9 @@
 #include <string>
 #include <memory>
 #include <filesystem>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
@@ -23,6 +26,7 @@
 #include "utils/Timer.hpp"
 #include "ui/UserInterface.hpp"
 #include "render/ShadowMap.hpp"
+#include "render/FrameCapture.hpp"
 
 // Constants and global variables
 uint SCR_WIDTH = 1000;
@@ -37,8 +41,6 @@ SceneManager sceneManager;
 glm::vec3 lightDir = glm::normalize(glm::vec3(-0.5f, -0.5f, -0.5f));
 glm::vec3 lightColor(1.0f, 1.0f, 1.0f);
 
-int frameCount = 0;
-
 bool create_directories_if_needed(const std::string &filePath) {
     try {
         std::filesystem::path path(filePath);
@@ -59,9 +61,7 @@ void SaveScreenshot(const char *filename) {
 
     // Invert image
     for (int y = 0; y < SCR_HEIGHT / 2; ++y) {
-        for (int x = 0; x < SCR_WIDTH * 3; ++x) {
-            std::swap(pixels[y * SCR_WIDTH * 3 + x], pixels[(SCR_HEIGHT - y - 1) * SCR_WIDTH * 3 + x]);
-        }
+        std::swap_ranges(pixels.begin() + y * SCR_WIDTH * 3, pixels.begin() + (y + 1) * SCR_WIDTH * 3, pixels.begin() + (SCR_HEIGHT - y - 1) * SCR_WIDTH * 3);
     }
 
     // Save
@@ -114,6 +114,9 @@ void key_callback(GLFWwindow *window, int key, int scancode, int action, int mod
         } else {
             glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         }
+    } else if (key == GLFW_KEY_BACKSPACE && action != GLFW_RELEASE && !ImGui::GetIO().WantCaptureKeyboard) {
+        // Held down: goes back one step per key repeat
+        sceneManager.rewind();
     } else if (key == GLFW_KEY_P && action == GLFW_PRESS) {
         SaveScreenshot("data/output/texture.png");
     }
@@ -189,7 +192,212 @@ void beginRender(ShaderProgram &shaderProgram) {
     shaderProgram.set("lightColor", lightColor);
 }
 
-int main() {
+std::unique_ptr<FrameCapture> createFrameCapture(const std::string &name, bool useFFmpeg, int fps = 60) {
+    const std::string output = "data/output/" + name;
+    if (!useFFmpeg) return std::make_unique<FrameCapture>(FrameCapture::Output::PNG, output, fps);
+
+    create_directories_if_needed(output + ".mp4");
+    const std::string command = "ffmpeg -y -loglevel error -f yuv4mpegpipe -i - -c:v libx264 -pix_fmt yuv420p \"" + output + ".mp4\"";
+    return std::make_unique<FrameCapture>(FrameCapture::Output::PIPE, command, fps);
+}
+
+// Command line options for the rendering without window
+struct HeadlessOptions {
+    bool headless = false;
+    SceneType scene = SceneType::CORD;
+    int frames = 600;
+    uint width = 1920, height = 1080;
+    int fps = 60; // the simulation step is 1 / fps
+    std::string output = "video";
+    bool useFFmpeg = false;
+    std::string replay; // input trace, which also gives the scene, the time steps and the number of frames
+    bool framesGiven = false;
+};
+
+void printUsage(const char *program) {
+    std::cout << "Usage: " << program << " [--headless [options]]\n"
+              << "  --scene <index|name>  scene to render (name without spaces, e.g. ClothDrop)\n"
+              << "  --frames <n>          number of frames (default 600)\n"
+              << "  --size <w>x<h>        resolution (default 1920x1080)\n"
+              << "  --fps <n>             frames per simulated second (default 60)\n"
+              << "  --output <name>       saved in data/output/<name> (default video)\n"
+              << "  --ffmpeg              encode to data/output/<name>.mp4 instead of PNG files\n"
+              << "  --replay <trace>      replay a recorded input trace (see Recording in the interface)" << std::endl;
+}
+
+// Whole argument as a decimal integer
+bool parseInt(const char *text, int &value) {
+    const char *end = text + strlen(text);
+    const auto [last, error] = std::from_chars(text, end, value);
+    if (error != std::errc() || last != end || last == text) {
+        std::cerr << "Invalid number: " << text << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool parseOptions(int argc, char **argv, HeadlessOptions &options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--ffmpeg") {
+            options.useFFmpeg = true;
+        } else if (arg == "--scene" && hasValue) {
+            std::string name = argv[++i];
+            int index = -1;
+            for (int k = 0; k < (int)Scenes::sceneNames.size(); k++) {
+                std::string sceneName = Scenes::sceneNames[k];
+                sceneName.erase(std::remove(sceneName.begin(), sceneName.end(), ' '), sceneName.end());
+                if (name == sceneName || name == std::to_string(k)) index = k;
+            }
+            if (index < 0) {
+                std::cerr << "Unknown scene: " << name << std::endl;
+                return false;
+            }
+            options.scene = static_cast<SceneType>(index);
+        } else if (arg == "--frames" && hasValue) {
+            if (!parseInt(argv[++i], options.frames)) return false;
+            options.framesGiven = true;
+        } else if (arg == "--fps" && hasValue) {
+            if (!parseInt(argv[++i], options.fps)) return false;
+            options.fps = std::max(1, options.fps);
+        } else if (arg == "--size" && hasValue) {
+            const std::string size = argv[++i];
+            const size_t x = size.find('x');
+            int width = 0, height = 0;
+            if (x == std::string::npos || !parseInt(size.substr(0, x).c_str(), width) || !parseInt(size.substr(x + 1).c_str(), height) ||
+                width <= 0 || height <= 0) {
+                std::cerr << "Invalid size: " << size << std::endl;
+                return false;
+            }
+            options.width = width;
+            options.height = height;
+        } else if (arg == "--replay" && hasValue) {
+            options.replay = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            options.output = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Renders the frames into the bound framebuffer object, with the scene, shaders and capture of the run
+int renderFrames(const HeadlessOptions &options, GLuint fbo) {
+    ShaderProgram shaderProgram("shaders/vertex_shader.glsl", "shaders/fragment_shader.glsl");
+    ShaderProgram checkerShaderProgram("shaders/vertex_shader.glsl", "shaders/checker_frag.glsl");
+    ShadowMap shadowMap("shaders/vertexShaderShadowMap.glsl", "shaders/fragmentShaderShadowMap.glsl", lightDir, camera, 2048, 2048);
+
+    // The shadow map unbinds the framebuffer when it is created
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
+
+    sceneManager.setSceneType(options.scene);
+    sceneManager.setFixedDt(1.0f / options.fps);
+
+    int frames = options.frames;
+    if (!options.replay.empty()) {
+        if (!sceneManager.startReplay(options.replay)) return -1;
+        if (!options.framesGiven) frames = sceneManager.getReplayFrameCount();
+    }
+
+    std::unique_ptr<FrameCapture> frameCapture = createFrameCapture(options.output, options.useFFmpeg, options.fps);
+    Timer timer;
+
+    for (int frame = 0; frame < frames; frame++) {
+        glClearColor(0.1, 0.1, 0.3, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        beginRender(shaderProgram);
+        beginRender(checkerShaderProgram);
+
+        sceneManager.updateScene();
+        sceneManager.drawScene(shaderProgram, checkerShaderProgram, shadowMap);
+
+        frameCapture->capture(SCR_WIDTH, SCR_HEIGHT);
+        if (!frameCapture->isOpen()) {
+            std::cerr << "Capture stopped at frame " << frame << std::endl;
+            return -1;
+        }
+
+        if ((frame + 1) % options.fps == 0) {
+            std::cout << "Frame " << frame + 1 << "/" << frames << " (" << options.fps / timer.elapsed() << " fps)" << std::endl;
+        }
+    }
+
+    // The destructor of the capture writes the last frames
+    return 0;
+}
+
+// The window is not drawn: the frames go to a framebuffer of the requested size
+int renderToFramebuffer(const HeadlessOptions &options) {
+    GLuint fbo, colorBuffer, depthBuffer;
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, SCR_WIDTH, SCR_HEIGHT);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, SCR_WIDTH, SCR_HEIGHT);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+    int result = -1;
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Framebuffer of " << SCR_WIDTH << "x" << SCR_HEIGHT << " is not complete" << std::endl;
+    } else {
+        result = renderFrames(options, fbo);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteRenderbuffers(1, &depthBuffer);
+    return result;
+}
+
+// Renders frames as fast as possible into a framebuffer object, at a fixed time step, without ImGui.
+// The window is hidden: with a GLFW built with GLFW_USE_OSMESA, no display is needed at all.
+int runHeadless(const HeadlessOptions &options) {
+    SCR_WIDTH = options.width;
+    SCR_HEIGHT = options.height;
+
+    initGLFW();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    window = glfwCreateWindow(1, 1, "XPBD", nullptr, nullptr);
+    if (window == nullptr) {
+        std::cerr << "Failed to create GLFW context" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+
+    int result = -1;
+    if (initOpenGL()) {
+        camera.setViewport(SCR_WIDTH, SCR_HEIGHT);
+        result = renderToFramebuffer(options);
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return result;
+}
+
+int main(int argc, char **argv) {
+    HeadlessOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return -1;
+    }
+    if (options.headless) return runHeadless(options);
+
     if (!init()) return -1;
 
     ShaderProgram shaderProgram("shaders/vertex_shader.glsl", "shaders/fragment_shader.glsl");
@@ -200,6 +408,8 @@ int main() {
 
     UserInterface userInterface(&sceneManager, window);
 
+    std::unique_ptr<FrameCapture> frameCapture;
+
     // Boucle de rendu
     while (!glfwWindowShouldClose(window)) {
 
@@ -213,18 +423,30 @@ int main() {
         sceneManager.updateScene();
         sceneManager.drawScene(shaderProgram, checkerShaderProgram, shadowMap);
 
-        if (sceneManager.getSaveVideo() && sceneManager.getPlay()) {
-            std::string filename = "data/output/" + std::string(sceneManager.saveFilename) + "/" + std::to_string(frameCount) + ".png";
-            SaveScreenshot(filename.c_str());
-            frameCount++;
+        if (sceneManager.getSaveVideo()) {
+            if (!frameCapture) frameCapture = createFrameCapture(sceneManager.saveFilename, sceneManager.pipeVideo);
+            if (sceneManager.getPlay()) frameCapture->capture(SCR_WIDTH, SCR_HEIGHT);
+
+            // The encoder could not be run or exited: the error is logged, recording stops
+            if (!frameCapture->isOpen()) sceneManager.setSaveVideo(false);
+        } else if (frameCapture) {
+            // Writes the last frames
+            frameCapture.reset();
         }
 
         userInterface.show();
 
         glfwSwapBuffers(window);
-        glfwPollEvents();
+
+        // Nothing moves while paused: wait for the next input instead of drawing the same frame again
+        if (sceneManager.getPlay() || sceneManager.isDragging())
+            glfwPollEvents();
+        else
+            glfwWaitEventsTimeout(0.1);
     }
 
+    frameCapture.reset();
+
     glfwDestroyWindow(window);
     glfwTerminate();
     return 0;
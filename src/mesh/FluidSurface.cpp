@@ -0,0 +1,301 @@
+#include "FluidSurface.hpp"
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <glm/gtx/norm.hpp>
+
+namespace {
+
+// Marching cubes cases, built once from the cube topology.
+// Corner c is at (c & 1, (c >> 1) & 1, (c >> 2) & 1). Each face with two crossed edges gives a segment;
+// ambiguous faces (four crossed edges) always separate the inside corners, so two cubes sharing a face agree
+// and the surface is closed. The segments are chained into polygons, oriented outward and triangulated as fans.
+struct CaseTable {
+    std::array<std::array<int, 2>, 12> edgeCorners;
+    std::array<int, 12> edgeAxis;
+    std::array<std::vector<std::array<int8_t, 3>>, 256> triangles;
+
+    CaseTable() {
+        int edgeOf[8][8];
+        int e = 0;
+        for (int a = 0; a < 3; a++) {
+            for (int c = 0; c < 8; c++) {
+                if (c >> a & 1) continue;
+                edgeCorners[e] = {c, c | 1 << a};
+                edgeAxis[e] = a;
+                edgeOf[c][c | 1 << a] = edgeOf[c | 1 << a][c] = e;
+                e++;
+            }
+        }
+
+        auto corner = [](int c) { return glm::vec3(c & 1, c >> 1 & 1, c >> 2 & 1); };
+
+        for (int config = 1; config < 255; config++) {
+            auto inside = [&](int c) { return (config >> c & 1) != 0; };
+
+            // Segments on the 6 faces
+            std::vector<std::array<int, 2>> segments;
+            for (int a = 0; a < 3; a++) {
+                for (int s = 0; s < 2; s++) {
+                    const int u = (a + 1) % 3, v = (a + 2) % 3;
+                    const int base = s << a;
+                    const int cycle[4] = {base, base | 1 << u, base | 1 << u | 1 << v, base | 1 << v};
+
+                    int crossed[4], nCrossed = 0;
+                    for (int k = 0; k < 4; k++) {
+                        if (inside(cycle[k]) != inside(cycle[(k + 1) % 4])) crossed[nCrossed++] = edgeOf[cycle[k]][cycle[(k + 1) % 4]];
+                    }
+
+                    if (nCrossed == 2) {
+                        segments.push_back({crossed[0], crossed[1]});
+                    } else if (nCrossed == 4 && inside(cycle[0])) {
+                        segments.push_back({crossed[3], crossed[0]});
+                        segments.push_back({crossed[1], crossed[2]});
+                    } else if (nCrossed == 4) {
+                        segments.push_back({crossed[0], crossed[1]});
+                        segments.push_back({crossed[2], crossed[3]});
+                    }
+                }
+            }
+
+            // Every crossed edge is in two segments: chain them into closed polygons
+            std::vector<bool> used(segments.size(), false);
+            for (size_t first = 0; first < segments.size(); first++) {
+                if (used[first]) continue;
+                used[first] = true;
+
+                std::vector<int> polygon = {segments[first][0]};
+                int current = segments[first][1];
+                while (current != polygon[0]) {
+                    polygon.push_back(current);
+                    for (size_t k = 0; k < segments.size(); k++) {
+                        if (used[k] || (segments[k][0] != current && segments[k][1] != current)) continue;
+                        used[k] = true;
+                        current = segments[k][0] == current ? segments[k][1] : segments[k][0];
+                        break;
+                    }
+                }
+
+                // Orient the polygon so that its normal points from the inside corners to the outside ones
+                glm::vec3 normal(0), outward(0);
+                for (size_t k = 0; k < polygon.size(); k++) {
+                    const auto &c0 = edgeCorners[polygon[k]];
+                    const auto &c1 = edgeCorners[polygon[(k + 1) % polygon.size()]];
+                    const glm::vec3 p0 = 0.5f * (corner(c0[0]) + corner(c0[1]));
+                    const glm::vec3 p1 = 0.5f * (corner(c1[0]) + corner(c1[1]));
+                    normal += glm::cross(p0, p1);
+                    outward += inside(c0[0]) ? corner(c0[1]) - corner(c0[0]) : corner(c0[0]) - corner(c0[1]);
+                }
+                if (glm::dot(normal, outward) < 0) std::reverse(polygon.begin() + 1, polygon.end());
+
+                for (size_t k = 1; k + 1 < polygon.size(); k++) {
+                    triangles[config].push_back({(int8_t)polygon[0], (int8_t)polygon[k], (int8_t)polygon[k + 1]});
+                }
+            }
+        }
+    }
+};
+
+const CaseTable &caseTable() {
+    static const CaseTable table;
+    return table;
+}
+
+// FNV-1a
+void hashBytes(uint64_t &hash, const void *data, size_t size) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+} // namespace
+
+FluidSurface::FluidSurface(float cellSize, float radius, float isoLevel, float tolerance)
+    : cellSize(cellSize), radius(radius), isoLevel(isoLevel), tolerance(tolerance) {
+    // A block only looks for particles in its 26 neighbours
+    if (radius > B * cellSize) {
+        throw std::runtime_error("FluidSurface radius must be smaller than a block.");
+    }
+}
+
+uint64_t FluidSurface::blockId(const glm::ivec3 &coord) {
+    return (uint64_t)(coord.x & 0x1FFFFF) << 42 | (uint64_t)(coord.y & 0x1FFFFF) << 21 | (uint64_t)(coord.z & 0x1FFFFF);
+}
+
+void FluidSurface::update(const std::vector<glm::vec3> &particles) {
+    const float blockSize = B * cellSize;
+
+    // Bin the particles by block, and activate every block their support touches
+    for (auto &[id, block] : blocks) {
+        block.active = false;
+        block.particles.clear();
+    }
+
+    for (uint i = 0; i < particles.size(); i++) {
+        const glm::ivec3 coord = glm::floor(particles[i] / blockSize);
+        blocks[blockId(coord)].particles.push_back(i);
+
+        const glm::ivec3 lo = glm::floor((particles[i] - radius) / blockSize);
+        const glm::ivec3 hi = glm::floor((particles[i] + radius) / blockSize);
+        for (int x = lo.x; x <= hi.x; x++) {
+            for (int y = lo.y; y <= hi.y; y++) {
+                for (int z = lo.z; z <= hi.z; z++) {
+                    Block &block = blocks[blockId({x, y, z})];
+                    block.coord = {x, y, z};
+                    block.active = true;
+                }
+            }
+        }
+    }
+
+    std::vector<Block *> active;
+    for (auto it = blocks.begin(); it != blocks.end();) {
+        if (!it->second.active) {
+            it = blocks.erase(it);
+        } else {
+            active.push_back(&it->second);
+            ++it;
+        }
+    }
+
+    // Mesh the blocks whose particles moved
+    uint count = 0;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(+ : count)
+    for (int b = 0; b < (int)active.size(); b++) {
+        Block &block = *active[b];
+
+        std::vector<uint> nearby;
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dz = -1; dz <= 1; dz++) {
+                    const auto it = blocks.find(blockId(block.coord + glm::ivec3(dx, dy, dz)));
+                    if (it != blocks.end()) nearby.insert(nearby.end(), it->second.particles.begin(), it->second.particles.end());
+                }
+            }
+        }
+
+        uint64_t key = 14695981039346656037ull;
+        for (uint i : nearby) {
+            if (tolerance > 0) {
+                const glm::i64vec3 q(glm::round(particles[i] / tolerance));
+                hashBytes(key, &q, sizeof(q));
+            } else {
+                hashBytes(key, &particles[i], sizeof(glm::vec3));
+            }
+        }
+
+        if (key == block.key) continue;
+        block.key = key;
+
+        polygonize(block, particles, nearby);
+        count++;
+    }
+
+    remeshed = count;
+
+    // Concatenate the blocks
+    std::vector<uint> vertexOffsets(active.size() + 1, 0), indexOffsets(active.size() + 1, 0);
+    for (size_t b = 0; b < active.size(); b++) {
+        vertexOffsets[b + 1] = vertexOffsets[b] + active[b]->vertices.size();
+        indexOffsets[b + 1] = indexOffsets[b] + active[b]->indices.size();
+    }
+
+    vertices.resize(vertexOffsets.back());
+    normals.resize(vertexOffsets.back());
+    indices.resize(indexOffsets.back());
+
+#pragma omp parallel for schedule(static)
+    for (int b = 0; b < (int)active.size(); b++) {
+        const Block &block = *active[b];
+        std::copy(block.vertices.begin(), block.vertices.end(), vertices.begin() + vertexOffsets[b]);
+        std::copy(block.normals.begin(), block.normals.end(), normals.begin() + vertexOffsets[b]);
+        for (size_t k = 0; k < block.indices.size(); k++) {
+            indices[indexOffsets[b] + k] = vertexOffsets[b] + block.indices[k];
+        }
+    }
+}
+
+void FluidSurface::polygonize(Block &block, const std::vector<glm::vec3> &particles, const std::vector<uint> &nearby) const {
+    // The block meshes its B^3 cells, so it needs (B + 1)^3 nodes
+    constexpr int N = B + 1;
+    auto node = [](int i, int j, int k) { return (k * N + j) * N + i; };
+
+    const glm::vec3 origin = glm::vec3(block.coord * B) * cellSize;
+    const float invR2 = 1.0f / (radius * radius);
+    const float reach = radius / cellSize;
+
+    // Splat: each particle adds (1 - r^2 / radius^2)^3 to the nodes of its support
+    std::vector<float> field(N * N * N, 0.0f);
+    std::vector<glm::vec3> grad(N * N * N, glm::vec3(0));
+
+    for (uint p : nearby) {
+        const glm::vec3 local = (particles[p] - origin) / cellSize;
+        const glm::ivec3 lo = glm::max(glm::ivec3(glm::ceil(local - reach)), glm::ivec3(0));
+        const glm::ivec3 hi = glm::min(glm::ivec3(glm::floor(local + reach)), glm::ivec3(N - 1));
+
+        for (int k = lo.z; k <= hi.z; k++) {
+            for (int j = lo.y; j <= hi.y; j++) {
+                for (int i = lo.x; i <= hi.x; i++) {
+                    const glm::vec3 d = origin + cellSize * glm::vec3(i, j, k) - particles[p];
+                    const float t = 1.0f - glm::length2(d) * invR2;
+                    if (t <= 0) continue;
+
+                    field[node(i, j, k)] += t * t * t;
+                    grad[node(i, j, k)] -= (6.0f * t * t * invR2) * d;
+                }
+            }
+        }
+    }
+
+    // March: vertices are shared through the edge they lie on (3 edges per node)
+    const CaseTable &table = caseTable();
+    std::vector<int> edgeVertex(3 * N * N * N, -1);
+
+    block.vertices.clear();
+    block.normals.clear();
+    block.indices.clear();
+
+    for (int k = 0; k < B; k++) {
+        for (int j = 0; j < B; j++) {
+            for (int i = 0; i < B; i++) {
+                int corners[8];
+                int config = 0;
+                for (int c = 0; c < 8; c++) {
+                    corners[c] = node(i + (c & 1), j + (c >> 1 & 1), k + (c >> 2 & 1));
+                    if (field[corners[c]] >= isoLevel) config |= 1 << c;
+                }
+
+                for (const auto &triangle : table.triangles[config]) {
+                    for (int e : triangle) {
+                        const int n0 = corners[table.edgeCorners[e][0]];
+                        const int n1 = corners[table.edgeCorners[e][1]];
+                        int &id = edgeVertex[3 * n0 + table.edgeAxis[e]];
+
+                        if (id < 0) {
+                            const float t = (isoLevel - field[n0]) / (field[n1] - field[n0]);
+                            const glm::vec3 p0 = origin + cellSize * glm::vec3(n0 % N, n0 / N % N, n0 / (N * N));
+                            glm::vec3 axis(0);
+                            axis[table.edgeAxis[e]] = cellSize;
+
+                            // The density decreases outward
+                            const glm::vec3 g = glm::mix(grad[n0], grad[n1], t);
+                            const float len = glm::length(g);
+
+                            id = block.vertices.size();
+                            block.vertices.push_back(p0 + t * axis);
+                            block.normals.push_back(len > 0 ? -g / len : glm::vec3(0, 1, 0));
+                        }
+
+                        block.indices.push_back(id);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+// Surface of a particle fluid, extracted with marching cubes
+// To use:
+//    - update with the particle positions: the density is splatted into a sparse grid of blocks,
+//      only around the particles, and each block is meshed independently in parallel
+//    - send getVertices, getNormals and getIndices to a Mesh (setGeometry)
+// A block whose particles did not move by more than tolerance keeps its triangles from the last update.
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class FluidSurface {
+public:
+    // cellSize: grid resolution. radius: support of each particle. isoLevel: in [0, 1], a lone particle peaks at 1.
+    FluidSurface(float cellSize, float radius, float isoLevel = 0.5f, float tolerance = 0.0f);
+
+    void update(const std::vector<glm::vec3> &particles);
+
+    const std::vector<glm::vec3> &getVertices() const { return vertices; }
+    const std::vector<glm::vec3> &getNormals() const { return normals; }
+    const std::vector<uint> &getIndices() const { return indices; }
+
+    uint getBlockCount() const { return blocks.size(); }
+    uint getRemeshedCount() const { return remeshed; }
+
+private:
+    static constexpr int B = 8; // cells per block side
+
+    struct Block {
+        glm::ivec3 coord;
+        uint64_t key = 0; // hash of the particles that touch the block
+        bool active = false;
+        std::vector<uint> particles; // particles inside the block
+        std::vector<glm::vec3> vertices;
+        std::vector<glm::vec3> normals;
+        std::vector<uint> indices;
+    };
+
+    float cellSize, radius, isoLevel, tolerance;
+    std::unordered_map<uint64_t, Block> blocks;
+    uint remeshed = 0;
+
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec3> normals;
+    std::vector<uint> indices;
+
+    static uint64_t blockId(const glm::ivec3 &coord);
+    void polygonize(Block &block, const std::vector<glm::vec3> &particles, const std::vector<uint> &nearby) const;
+};
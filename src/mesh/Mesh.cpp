@@ -1,4 +1,6 @@
 #include "Mesh.hpp"
+#include "MeshLoader.hpp"
+#include "Topology.hpp"
 
 #include <glad/gl.h>
 #include <glm/glm.hpp>
@@ -6,6 +8,8 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <cmath>
 
 #define PI 3.14159265359
 
@@ -13,35 +17,18 @@ Mesh::Mesh(const std::vector<glm::vec3> &vertices, const std::vector<glm::vec3>
     : vertices(vertices), normals(normals), indices(indices), indexCount(indices.size()), name(name) {
 
     hasTextures = false;
-
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &NBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
-    glEnableVertexAttribArray(0);
-
-    glBindBuffer(GL_ARRAY_BUFFER, NBO);
-    glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(glm::vec3), normals.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
-    glEnableVertexAttribArray(1);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint), indices.data(), GL_STATIC_DRAW);
-
-    glBindVertexArray(0);
+    hasNormals = true;
 }
 
 Mesh::Mesh(const std::vector<glm::vec3> &vertices, const std::vector<glm::vec3> &normals, const std::vector<glm::vec2> &textures, const std::vector<uint> &indices, const std::string &name)
-    : vertices(vertices), normals(normals), indices(indices), indexCount(indices.size()), name(name) {
+    : vertices(vertices), normals(normals), textures(textures), indices(indices), indexCount(indices.size()), name(name) {
 
     hasTextures = (textures.size() != 0);
     hasNormals = (normals.size() != 0);
+}
+
+void Mesh::createGL() {
+    if (VAO) return;
 
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -74,9 +61,13 @@ Mesh::Mesh(const std::vector<glm::vec3> &vertices, const std::vector<glm::vec3>
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint), indices.data(), GL_STATIC_DRAW);
 
     glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (dynamic) createRing();
 }
 
 void Mesh::draw(uint shaderProgram, const glm::vec3 &color, const glm::mat4 &modelMat) {
+    createGL();
     glUseProgram(shaderProgram);
 
     int colorLoc = glGetUniformLocation(shaderProgram, "objectColor");
@@ -86,22 +77,24 @@ void Mesh::draw(uint shaderProgram, const glm::vec3 &color, const glm::mat4 &mod
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(modelMat));
 
     glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+    drawElements();
     glBindVertexArray(0);
 }
 
 void Mesh::draw(ShaderProgram &shaderProgram, const glm::vec3 &color, const glm::mat4 &modelMat) {
+    createGL();
     shaderProgram.use();
 
     shaderProgram.set("objectColor", color);
     shaderProgram.set("model", modelMat);
 
     glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+    drawElements();
     glBindVertexArray(0);
 }
 
 void Mesh::startDrawMultiple(ShaderProgram &shaderProgram) {
+    createGL();
     shaderProgram.use();
     glBindVertexArray(VAO);
 }
@@ -109,71 +102,195 @@ void Mesh::startDrawMultiple(ShaderProgram &shaderProgram) {
 void Mesh::addDrawMultiple(ShaderProgram &shaderProgram, const glm::vec3 &color, const glm::mat4 &modelMat) {
     shaderProgram.set("objectColor", color);
     shaderProgram.set("model", modelMat);
-    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+    drawElements();
 }
 
 void Mesh::endDrawMultiple() {
     glBindVertexArray(0);
 }
 
-void Mesh::updateNormals() {
-    normals.resize(vertices.size(), glm::vec3(0.0f));
+void Mesh::drawElements() {
+    if (dirty) flush();
+    glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, baseVertex);
+}
 
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        uint i0 = indices[i];
-        uint i1 = indices[i + 1];
-        uint i2 = indices[i + 2];
+void Mesh::makeDynamic() {
+    dynamic = true;
+    hasNormals = true;
+    dirty = true;
+    if (VAO) createRing(); // else with the other GL objects
+}
 
-        const glm::vec3 &v0 = vertices[i0];
-        const glm::vec3 &v1 = vertices[i1];
-        const glm::vec3 &v2 = vertices[i2];
+void Mesh::createRing() {
+    const size_t n = vertices.size();
+    ring = std::make_unique<RingBuffer>(2 * n * sizeof(glm::vec3));
 
-        glm::vec3 edge1 = v1 - v0;
-        glm::vec3 edge2 = v2 - v0;
-        glm::vec3 faceNormal = glm::normalize(glm::cross(edge1, edge2));
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, ring->getBuffer());
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)(n * sizeof(glm::vec3)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Mesh::setVertexSource(const std::vector<glm::vec3> &pos, const std::vector<uint> *remap) {
+    source = &pos;
+    sourceRemap = remap && !remap->empty() ? remap : nullptr;
 
-        normals[i0] += faceNormal;
-        normals[i1] += faceNormal;
-        normals[i2] += faceNormal;
+    const size_t n = sourceRemap ? sourceRemap->size() : pos.size();
+    if (n != vertices.size()) std::cerr << "vertex source must have as many vertices as the mesh in setVertexSource" << std::endl;
+
+    if (!dynamic) makeDynamic();
+    dirty = true;
+}
+
+void Mesh::flush() {
+    const int n = vertices.size();
+    char *slot = static_cast<char *>(ring->advance());
+    glm::vec3 *dst = reinterpret_cast<glm::vec3 *>(slot);
+
+    // The remap of the source is done while writing to the GPU memory
+    if (source) {
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; i++) {
+            dst[i] = vertexAt(i);
+        }
+    } else {
+        std::copy(vertices.begin(), vertices.end(), dst);
     }
 
-    for (glm::vec3 &normal : normals) {
-        normal = glm::normalize(normal);
+    std::copy(normals.begin(), normals.begin() + std::min((size_t)n, normals.size()), dst + n);
+    ring->commit();
+
+    baseVertex = 2 * n * ring->getSlot();
+    dirty = false;
+}
+
+void Mesh::uploadVertices() {
+    if (ring) {
+        dirty = true;
+        return;
     }
+    if (!VAO) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(glm::vec3), vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Mesh::uploadNormals() {
+    if (ring) {
+        dirty = true;
+        return;
+    }
+    if (!VAO) return;
 
     glBindBuffer(GL_ARRAY_BUFFER, NBO);
     glBufferSubData(GL_ARRAY_BUFFER, 0, normals.size() * sizeof(glm::vec3), normals.data());
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+void Mesh::buildVertexFaces() {
+    Topology::vertexElements(indices, 3, vertices.size(), vertexFaceOffsets, vertexFaces);
+    faceNormals.resize(indices.size() / 3);
+}
+
+void Mesh::updateNormals() {
+    if (vertexFaceOffsets.size() != vertices.size() + 1) buildVertexFaces();
+
+    const int nFaces = faceNormals.size();
+    const int nVertices = vertices.size();
+    normals.resize(nVertices);
+
+    // Face normals weighted by the area: the cross product is not normalized
+#pragma omp parallel for schedule(static)
+    for (int f = 0; f < nFaces; f++) {
+        const glm::vec3 v0 = vertexAt(indices[3 * f]);
+        const glm::vec3 e1 = vertexAt(indices[3 * f + 1]) - v0;
+        const glm::vec3 e2 = vertexAt(indices[3 * f + 2]) - v0;
+        faceNormals[f] = glm::vec3(e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x);
+    }
+
+    // Each vertex gathers its faces: no write conflict, one normalization
+#pragma omp parallel for schedule(static)
+    for (int v = 0; v < nVertices; v++) {
+        glm::vec3 n(0.0f);
+        for (uint k = vertexFaceOffsets[v]; k < vertexFaceOffsets[v + 1]; k++) {
+            n += faceNormals[vertexFaces[k]];
+        }
+
+        const float len2 = n.x * n.x + n.y * n.y + n.z * n.z;
+        normals[v] = len2 > 0.0f ? n * (1.0f / std::sqrt(len2)) : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+
+    uploadNormals();
+}
+
+void Mesh::setFlippedNormals(const Mesh &other) {
+    const int n = other.normals.size();
+    normals.resize(n);
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        normals[i] = -other.normals[i];
+    }
+
+    uploadNormals();
+}
+
 void Mesh::setVertices(const std::vector<glm::vec3> &vertices) {
     if (this->vertices.size() != vertices.size()) std::cerr << "vertices must be the same size as current one in setVertices" << std::endl;
     this->vertices = vertices;
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(glm::vec3), vertices.data());
+    source = nullptr;
+    uploadVertices();
+}
+
+void Mesh::setGeometry(const std::vector<glm::vec3> &vertices, const std::vector<glm::vec3> &normals, const std::vector<uint> &indices) {
+    this->vertices = vertices;
+    this->normals = normals;
+    this->indices = indices;
+    indexCount = indices.size();
+    vertexFaceOffsets.clear();
+    if (!VAO) return;
+
+    // The ring of a dynamic mesh is sized for the vertex count
+    if (ring) createRing();
+
+    glBindVertexArray(VAO);
+
+    if (!ring) {
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_DYNAMIC_DRAW);
+
+        glBindBuffer(GL_ARRAY_BUFFER, NBO);
+        glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(glm::vec3), normals.data(), GL_DYNAMIC_DRAW);
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint), indices.data(), GL_DYNAMIC_DRAW);
+
+    glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void Mesh::updateVertices() {
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(glm::vec3), vertices.data());
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    uploadVertices();
 }
 
 void Mesh::applyTransform(const glm::mat4 &mat) {
     for (glm::vec3 &pos : vertices) {
         pos = glm::vec3(mat * glm::vec4(pos, 1.0f));
     }
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(glm::vec3), vertices.data());
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    uploadVertices();
 }
 
 Mesh::~Mesh() {
+    if (!VAO) return;
     glDeleteBuffers(1, &VBO);
     glDeleteBuffers(1, &EBO);
-    if (hasNormals) glDeleteBuffers(1, &NBO);
-    if (hasTextures) glDeleteBuffers(1, &TBO);
+    glDeleteBuffers(1, &NBO);
+    glDeleteBuffers(1, &TBO);
     glDeleteVertexArrays(1, &VAO);
 }
 
@@ -426,6 +543,24 @@ std::shared_ptr<Mesh> Mesh::createPlane(const std::vector<glm::vec3> &pos, int w
     return mesh;
 }
 
+std::shared_ptr<Mesh> Mesh::createHeightfield(const Heightfield &heightfield) {
+    const int nx = heightfield.getSizeX();
+    const int nz = heightfield.getSizeZ();
+
+    std::vector<glm::vec3> pos;
+    pos.reserve(nx * nz);
+    for (int j = 0; j < nz; j++) {
+        for (int i = 0; i < nx; i++) {
+            pos.push_back(heightfield.getVertex(i, j));
+        }
+    }
+
+    std::shared_ptr<Mesh> mesh = createPlane(pos, nx, nz);
+    mesh->setName("Heightfield");
+
+    return mesh;
+}
+
 std::shared_ptr<Mesh> Mesh::createQuad() {
     std::vector<glm::vec3> vertices = {
         {-1.0f, 1.0f, 0.0f},
@@ -580,57 +715,11 @@ std::shared_ptr<Mesh> Mesh::createTore(int resolution) {
 }
 
 std::shared_ptr<Mesh> Mesh::createFromOFF(const std::string &filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file: " + filePath);
-    }
-
-    std::string line;
-    // Read the header
-    std::getline(file, line);
-    if (line != "OFF") {
-        throw std::runtime_error("File is not in OFF format.");
-    }
-
-    // Read the number of vertices, faces, and edges
-    size_t numVertices = 0, numFaces = 0, numEdges = 0;
-    std::getline(file, line);
-    std::istringstream headerStream(line);
-    headerStream >> numVertices >> numFaces >> numEdges;
-
-    std::vector<glm::vec3> vertices;
-    std::vector<uint> indices;
-
-    // Read vertices
-    for (size_t i = 0; i < numVertices; ++i) {
-        float x, y, z;
-        std::getline(file, line);
-        std::istringstream vertexStream(line);
-        vertexStream >> x >> y >> z;
-        vertices.emplace_back(x, y, z);
-    }
-
-    // Read faces
-    for (size_t i = 0; i < numFaces; ++i) {
-        std::getline(file, line);
-        std::istringstream faceStream(line);
-        size_t faceSize;
-        faceStream >> faceSize;
-        if (faceSize != 3) {
-            throw std::runtime_error("Only triangular faces are supported.");
-        }
-        uint v1, v2, v3;
-        faceStream >> v1 >> v2 >> v3;
-        indices.push_back(v1);
-        indices.push_back(v2);
-        indices.push_back(v3);
-    }
-
-    file.close();
+    const MeshData data = MeshLoader::loadOFF(filePath, MeshLoader::defaultCachePath(filePath));
 
-    std::vector<glm::vec3> normals(numVertices);
+    std::vector<glm::vec3> normals(data.vertices.size());
 
-    std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>(vertices, normals, indices);
+    std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>(data.vertices, normals, data.indices);
     mesh->updateNormals();
 
     return mesh;
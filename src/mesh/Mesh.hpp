@@ -1,4 +1,6 @@
 // Helper class to load, send to GPU and transform a mesh
+// The GL objects are created at the first draw (or getVAO), on the thread of the GL context:
+// meshes can be built on another thread, with the geometry kept on the CPU until then.
 
 #ifndef MESH_HPP
 #define MESH_HPP
@@ -9,6 +11,8 @@
 #include <memory>
 #include <string>
 #include "render/ShaderProgram.hpp"
+#include "render/RingBuffer.hpp"
+#include "utils/Heightfield.hpp"
 
 class Mesh {
 public:
@@ -23,12 +27,28 @@ public:
     void addDrawMultiple(ShaderProgram &shaderProgram, const glm::vec3 &color, const glm::mat4 &modelMat);
     void endDrawMultiple();
 
+    // glDrawElements on the bound VAO, uploads the geometry first if the mesh is dynamic
+    void drawElements();
+
     void updateNormals();
+    // Normals of a mesh with the same vertices and the opposite winding (back side of a cloth)
+    void setFlippedNormals(const Mesh &other);
     void updateVertices();
 
     void setVertices(const std::vector<glm::vec3> &vertices);
+    // Replaces the whole geometry, whose size may change (generated meshes)
+    void setGeometry(const std::vector<glm::vec3> &vertices, const std::vector<glm::vec3> &normals, const std::vector<uint> &indices);
     void applyTransform(const glm::mat4 &mat);
 
+    // For meshes updated every frame: vertices and normals go to a triple buffered ring,
+    // uploaded once per frame at the first draw instead of at every update
+    void makeDynamic();
+
+    // The vertices are read from pos (through remap if given) at each upload, instead of being copied into the mesh.
+    // pos must outlive the mesh. Makes the mesh dynamic; call updateVertices or updateNormals when pos changes.
+    // Several meshes can share a source, e.g. both sides of a cloth: none of them holds a stale copy after a step.
+    void setVertexSource(const std::vector<glm::vec3> &pos, const std::vector<uint> *remap = nullptr);
+
     static std::shared_ptr<Mesh> createCube(float w = 1.0f);
     static std::shared_ptr<Mesh> createSphere(float radius = 1.0f, int resolution = 16);
     static std::shared_ptr<Mesh> createPlane();
@@ -38,26 +58,58 @@ public:
     static std::shared_ptr<Mesh> createTore(int resolution = 16);
     static std::shared_ptr<Mesh> createCylinder(float L, float r, uint resolution = 16);
     static std::shared_ptr<Mesh> createFromOFF(const std::string &filePath);
+    static std::shared_ptr<Mesh> createHeightfield(const Heightfield &heightfield);
 
-    const uint getVAO() const { return VAO; }
+    uint getVAO() {
+        createGL();
+        return VAO;
+    }
     const uint getIndexCount() const { return indexCount; }
 
     void setName(std::string newName) { name = newName; }
     std::string getName() const { return name; }
 
+    // With a vertex source, these are the vertices from before it was set
     const std::vector<glm::vec3> &getVertices() const { return vertices; }
     const std::vector<glm::vec3> &getNormals() const { return normals; }
     const std::vector<uint> &getIndices() const { return indices; }
 
 protected:
-    uint VAO, VBO, NBO, TBO, EBO;
+    uint VAO = 0, VBO = 0, NBO = 0, TBO = 0, EBO = 0;
     bool hasNormals, hasTextures;
+    bool dynamic = false;
     size_t indexCount;
     std::string name;
 
     std::vector<glm::vec3> vertices;
     std::vector<glm::vec3> normals;
+    std::vector<glm::vec2> textures;
     std::vector<uint> indices;
+
+    const std::vector<glm::vec3> *source = nullptr;
+    const std::vector<uint> *sourceRemap = nullptr;
+
+    glm::vec3 vertexAt(size_t i) const {
+        if (!source) return vertices[i];
+        return sourceRemap ? (*source)[(*sourceRemap)[i]] : (*source)[i];
+    }
+
+    // Dynamic geometry: slot k holds the vertices then the normals, drawn with a base vertex of 2 k n
+    std::unique_ptr<RingBuffer> ring;
+    bool dirty = false;
+    GLint baseVertex = 0;
+
+    // Faces around each vertex: vertexFaces[vertexFaceOffsets[v], vertexFaceOffsets[v + 1]), built at the first updateNormals
+    std::vector<uint> vertexFaceOffsets;
+    std::vector<uint> vertexFaces;
+    std::vector<glm::vec3> faceNormals;
+
+    void createGL();
+    void createRing();
+    void buildVertexFaces();
+    void uploadVertices();
+    void uploadNormals();
+    void flush();
 };
 
 #endif // MESH_HPP
@@ -0,0 +1,460 @@
+#include "MeshLoader.hpp"
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t VERSION = 2;
+constexpr uint32_t TET_VERSION = 1;
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceTime; // modification time of the OFF file, in nanoseconds
+    uint32_t nVertices, nIndices, nEdges;
+    uint32_t reserved;
+};
+
+// Binary tetrahedral mesh. The source is 0 for the files written by saveTet.
+struct TetHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize; // sum of the sizes of the TetGen files
+    int64_t sourceTime;  // latest modification time of the TetGen files, in nanoseconds
+    uint32_t nPos, nTets, nEdges, nIndices, nSurface;
+    uint32_t reserved;
+};
+
+// Read only mapping of a whole file
+class MappedFile {
+public:
+    MappedFile(const std::string &path) {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                data = static_cast<const char *>(mapping);
+                size = st.st_size;
+                time = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+            }
+        }
+        close(fd);
+    }
+
+    ~MappedFile() {
+        if (data) munmap(const_cast<char *>(data), size);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data = nullptr;
+    size_t size = 0;
+    int64_t time = 0;
+};
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Parses the next number of [p, end), after spaces. p moves past it.
+template <typename T>
+bool parse(const char *&p, const char *end, T &value) {
+    while (p < end && isSpace(*p)) p++;
+    const std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) return false;
+    p = result.ptr;
+    return true;
+}
+
+// Lines of [begin, end) that are neither empty nor comments
+std::vector<const char *> findLines(const char *begin, const char *end) {
+    std::vector<const char *> lines;
+    const char *p = begin;
+    while (p < end) {
+        const char *next = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        next = next ? next + 1 : end;
+
+        const char *first = p;
+        while (first < next && isSpace(*first)) first++;
+        if (first < next && *first != '#') lines.push_back(p);
+
+        p = next;
+    }
+    return lines;
+}
+
+bool loadCache(const std::string &path, const MappedFile &source, MeshData &mesh) {
+    MappedFile cache(path);
+    if (!cache.data || cache.size < sizeof(CacheHeader)) return false;
+
+    CacheHeader header;
+    std::memcpy(&header, cache.data, sizeof(header));
+    if (std::memcmp(header.magic, "MESH", 4) != 0 || header.version != VERSION || header.sourceSize != source.size ||
+        header.sourceTime != source.time) {
+        return false;
+    }
+
+    const size_t expected = sizeof(header) + header.nVertices * sizeof(glm::vec3) +
+                            ((size_t)header.nIndices + header.nEdges) * sizeof(uint);
+    if (cache.size != expected) return false;
+
+    const char *p = cache.data + sizeof(header);
+    auto read = [&](auto &vector, size_t count) {
+        vector.resize(count);
+        std::memcpy(vector.data(), p, count * sizeof(vector[0]));
+        p += count * sizeof(vector[0]);
+    };
+    read(mesh.vertices, header.nVertices);
+    read(mesh.indices, header.nIndices);
+    read(mesh.edges, header.nEdges);
+    return true;
+}
+
+void saveCache(const std::string &path, const MappedFile &source, const MeshData &mesh) {
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Could not write mesh cache: " << path << std::endl;
+        return;
+    }
+
+    const CacheHeader header = {{'M', 'E', 'S', 'H'}, VERSION, source.size, source.time,
+                                (uint32_t)mesh.vertices.size(), (uint32_t)mesh.indices.size(), (uint32_t)mesh.edges.size(), 0};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    auto write = [&](const auto &vector) {
+        file.write(reinterpret_cast<const char *>(vector.data()), vector.size() * sizeof(vector[0]));
+    };
+    write(mesh.vertices);
+    write(mesh.indices);
+    write(mesh.edges);
+}
+
+bool readTet(const MappedFile &file, TetMeshData &mesh, TetHeader &header) {
+    if (!file.data || file.size < sizeof(TetHeader)) return false;
+
+    std::memcpy(&header, file.data, sizeof(header));
+    if (std::memcmp(header.magic, "TETS", 4) != 0 || header.version != TET_VERSION) return false;
+
+    const size_t expected = sizeof(header) + header.nPos * sizeof(glm::vec3) +
+                            (4 * (size_t)header.nTets + header.nEdges + header.nIndices + header.nSurface) * sizeof(uint);
+    if (file.size != expected) return false;
+
+    const char *p = file.data + sizeof(header);
+    auto read = [&](auto &vector, size_t count) {
+        vector.resize(count);
+        std::memcpy(vector.data(), p, count * sizeof(vector[0]));
+        p += count * sizeof(vector[0]);
+    };
+    read(mesh.pos, header.nPos);
+    read(mesh.tets, 4 * (size_t)header.nTets);
+    read(mesh.edges, header.nEdges);
+    read(mesh.indices, header.nIndices);
+    read(mesh.meshToPos, header.nSurface);
+    return true;
+}
+
+bool writeTet(const std::string &path, const TetMeshData &mesh, uint64_t sourceSize, int64_t sourceTime) {
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    const TetHeader header = {{'T', 'E', 'T', 'S'}, TET_VERSION, sourceSize, sourceTime, (uint32_t)mesh.pos.size(), (uint32_t)(mesh.tets.size() / 4),
+                              (uint32_t)mesh.edges.size(), (uint32_t)mesh.indices.size(), (uint32_t)mesh.meshToPos.size(), 0};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    auto write = [&](const auto &vector, size_t count) {
+        file.write(reinterpret_cast<const char *>(vector.data()), count * sizeof(vector[0]));
+    };
+    write(mesh.pos, mesh.pos.size());
+    write(mesh.tets, 4 * header.nTets);
+    write(mesh.edges, mesh.edges.size());
+    write(mesh.indices, mesh.indices.size());
+    write(mesh.meshToPos, mesh.meshToPos.size());
+    return file.good();
+}
+
+// A TetGen file: a header line, then one line per element, starting with its index
+struct TetGenFile {
+    std::vector<const char *> lines;
+    const char *end;
+
+    TetGenFile(const MappedFile &file, const std::string &path) : end(file.data + file.size) {
+        lines = findLines(file.data, end);
+        if (lines.empty()) throw std::runtime_error("Empty TetGen file: " + path);
+    }
+
+    const char *lineEnd(size_t line) const { return line + 1 < lines.size() ? lines[line + 1] : end; }
+
+    // First numbers of the header line
+    std::array<size_t, 4> header() const {
+        std::array<size_t, 4> values = {0, 0, 0, 0};
+        const char *p = lines[0];
+        for (size_t &value : values) {
+            if (!parse(p, lineEnd(0), value)) break;
+        }
+        return values;
+    }
+
+    // Index of the first element: 0 or 1
+    size_t base() const {
+        const char *p = lines.size() > 1 ? lines[1] : end;
+        size_t index = 0;
+        parse(p, lineEnd(1), index);
+        return index;
+    }
+};
+
+// The first corners of each element of a .ele or .face file, from 0
+std::vector<uint> readElements(const TetGenFile &file, const std::string &path, size_t count, uint corners, size_t base, size_t nPos) {
+    if (file.lines.size() < count + 1) throw std::runtime_error("TetGen file is truncated: " + path);
+
+    std::vector<uint> elements(corners * count);
+    bool valid = true;
+
+#pragma omp parallel for schedule(static) reduction(&& : valid)
+    for (long long i = 0; i < (long long)count; i++) {
+        const char *p = file.lines[i + 1];
+        const char *e = file.lineEnd(i + 1);
+        size_t index;
+        valid = parse(p, e, index) && valid;
+        for (uint k = 0; k < corners; k++) {
+            size_t v = 0;
+            valid = parse(p, e, v) && v >= base && v - base < nPos && valid;
+            elements[corners * i + k] = v - base;
+        }
+    }
+
+    if (!valid) throw std::runtime_error("Could not parse TetGen file: " + path);
+    return elements;
+}
+
+// Keeps the faces of the surface, oriented outwards, and numbers the surface vertices
+void buildSurface(TetMeshData &mesh, const std::vector<uint> *fileFaces) {
+    std::vector<uint> opposite;
+    std::vector<uint> faces = Topology::boundaryFaces(mesh.tets, &opposite);
+
+    if (fileFaces) {
+        // Fourth corner of each boundary face, found by its sorted corners
+        std::vector<std::array<uint, 4>> boundary(opposite.size());
+        for (size_t f = 0; f < boundary.size(); f++) {
+            std::array<uint, 4> &b = boundary[f];
+            b = {faces[3 * f], faces[3 * f + 1], faces[3 * f + 2], opposite[f]};
+            std::sort(b.begin(), b.begin() + 3);
+        }
+        std::sort(boundary.begin(), boundary.end());
+
+        faces.clear();
+        opposite.clear();
+        for (size_t f = 0; f + 2 < fileFaces->size(); f += 3) {
+            std::array<uint, 4> key = {(*fileFaces)[f], (*fileFaces)[f + 1], (*fileFaces)[f + 2], 0};
+            std::sort(key.begin(), key.begin() + 3);
+            const auto it = std::lower_bound(boundary.begin(), boundary.end(), key);
+            if (it == boundary.end() || !std::equal(key.begin(), key.begin() + 3, it->begin())) continue; // inner face
+
+            faces.insert(faces.end(), fileFaces->begin() + f, fileFaces->begin() + f + 3);
+            opposite.push_back((*it)[3]);
+        }
+    }
+
+    const long long nFaces = opposite.size();
+#pragma omp parallel for schedule(static)
+    for (long long f = 0; f < nFaces; f++) {
+        const glm::vec3 &a = mesh.pos[faces[3 * f]];
+        const glm::vec3 n = glm::cross(mesh.pos[faces[3 * f + 1]] - a, mesh.pos[faces[3 * f + 2]] - a);
+        if (glm::dot(n, mesh.pos[opposite[f]] - a) > 0) std::swap(faces[3 * f + 1], faces[3 * f + 2]);
+    }
+
+    // Surface vertices in the order of the particles
+    std::vector<uint> surfaceIndex(mesh.pos.size(), Topology::NONE);
+    for (uint v : faces) surfaceIndex[v] = 0;
+    mesh.meshToPos.clear();
+    for (uint v = 0; v < surfaceIndex.size(); v++) {
+        if (surfaceIndex[v] == 0) {
+            surfaceIndex[v] = mesh.meshToPos.size();
+            mesh.meshToPos.push_back(v);
+        }
+    }
+
+    mesh.indices.resize(faces.size());
+#pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)faces.size(); i++) {
+        mesh.indices[i] = surfaceIndex[faces[i]];
+    }
+}
+
+} // namespace
+
+std::string MeshLoader::defaultCachePath(const std::string &path, const std::string &extension) {
+    return "data/cache/" + std::filesystem::path(path).filename().string() + extension;
+}
+
+MeshData MeshLoader::loadOFF(const std::string &path, const std::string &cachePath) {
+    MappedFile file(path);
+    if (!file.data) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+
+    MeshData mesh;
+    if (!cachePath.empty() && loadCache(cachePath, file, mesh)) return mesh;
+
+    const char *end = file.data + file.size;
+    const std::vector<const char *> lines = findLines(file.data, end);
+
+    // Header: "OFF", then the counts, on the same line or the next one
+    if (lines.empty() || std::strncmp(lines[0], "OFF", 3) != 0) {
+        throw std::runtime_error("File is not in OFF format.");
+    }
+    const char *p = lines[0] + 3;
+    size_t numVertices = 0, numFaces = 0, numEdges = 0, first = 1;
+    if (!parse(p, lines.size() > 1 ? lines[1] : end, numVertices)) {
+        if (lines.size() < 2) throw std::runtime_error("File is not in OFF format.");
+        p = lines[1];
+        first = 2;
+        parse(p, end, numVertices);
+    }
+    parse(p, end, numFaces);
+    parse(p, end, numEdges);
+
+    if (lines.size() < first + numVertices + numFaces) {
+        throw std::runtime_error("OFF file is truncated: " + path);
+    }
+
+    mesh.vertices.resize(numVertices);
+    mesh.indices.resize(3 * numFaces);
+    bool valid = true, triangles = true;
+
+    auto lineEnd = [&](size_t line) { return line + 1 < lines.size() ? lines[line + 1] : end; };
+
+#pragma omp parallel for schedule(static) reduction(&& : valid)
+    for (long long i = 0; i < (long long)numVertices; i++) {
+        const char *q = lines[first + i];
+        const char *e = lineEnd(first + i);
+        glm::vec3 &v = mesh.vertices[i];
+        valid = parse(q, e, v.x) && parse(q, e, v.y) && parse(q, e, v.z) && valid;
+    }
+
+#pragma omp parallel for schedule(static) reduction(&& : valid, triangles)
+    for (long long i = 0; i < (long long)numFaces; i++) {
+        const size_t line = first + numVertices + i;
+        const char *q = lines[line];
+        const char *e = lineEnd(line);
+        uint faceSize = 0;
+        valid = parse(q, e, faceSize) && valid;
+        triangles = faceSize == 3 && triangles;
+        valid = parse(q, e, mesh.indices[3 * i]) && parse(q, e, mesh.indices[3 * i + 1]) && parse(q, e, mesh.indices[3 * i + 2]) && valid;
+    }
+
+    if (!triangles) {
+        throw std::runtime_error("Only triangular faces are supported.");
+    }
+    if (!valid) {
+        throw std::runtime_error("Could not parse OFF file: " + path);
+    }
+    for (uint index : mesh.indices) {
+        if (index >= numVertices) throw std::runtime_error("OFF file has an invalid vertex index: " + path);
+    }
+
+    mesh.edges = Topology::uniqueEdges(mesh.indices, 3);
+
+    if (!cachePath.empty()) saveCache(cachePath, file, mesh);
+
+    return mesh;
+}
+
+TetMeshData MeshLoader::loadTetGen(const std::string &basePath, const std::string &cachePath) {
+    const MappedFile node(basePath + ".node"), ele(basePath + ".ele"), face(basePath + ".face");
+    if (!node.data) throw std::runtime_error("Could not open file: " + basePath + ".node");
+    if (!ele.data) throw std::runtime_error("Could not open file: " + basePath + ".ele");
+
+    const uint64_t sourceSize = node.size + ele.size + face.size;
+    const int64_t sourceTime = std::max({node.time, ele.time, face.time});
+
+    TetMeshData mesh;
+    if (!cachePath.empty()) {
+        TetHeader header;
+        if (readTet(MappedFile(cachePath), mesh, header) && header.sourceSize == sourceSize && header.sourceTime == sourceTime) return mesh;
+        mesh = TetMeshData();
+    }
+
+    // .node: <points> <dimension> <attributes> <boundary marker>, then <index> <x> <y> <z> ...
+    const TetGenFile nodes(node, basePath + ".node");
+    const size_t nPos = nodes.header()[0];
+    if (nodes.header()[1] != 3) throw std::runtime_error("TetGen points must be in 3D: " + basePath + ".node");
+    if (nodes.lines.size() < nPos + 1) throw std::runtime_error("TetGen file is truncated: " + basePath + ".node");
+
+    const size_t base = nodes.base();
+    mesh.pos.resize(nPos);
+    bool valid = true;
+
+#pragma omp parallel for schedule(static) reduction(&& : valid)
+    for (long long i = 0; i < (long long)nPos; i++) {
+        const char *p = nodes.lines[i + 1];
+        const char *e = nodes.lineEnd(i + 1);
+        size_t index;
+        glm::vec3 &v = mesh.pos[i];
+        valid = parse(p, e, index) && parse(p, e, v.x) && parse(p, e, v.y) && parse(p, e, v.z) && valid;
+    }
+    if (!valid) throw std::runtime_error("Could not parse TetGen file: " + basePath + ".node");
+
+    // .ele: <tetrahedra> <nodes per tetrahedron> <attributes>, then <index> <corners> ...
+    const TetGenFile elements(ele, basePath + ".ele");
+    const size_t nTets = elements.header()[0], nodesPerTet = elements.header()[1];
+    if (nodesPerTet != 4 && nodesPerTet != 10) throw std::runtime_error("TetGen tetrahedra must have 4 or 10 nodes: " + basePath + ".ele");
+    if (nodesPerTet == 4) {
+        mesh.tets = readElements(elements, basePath + ".ele", nTets, 4, base, nPos);
+    } else {
+        // Quadratic tetrahedra: the corners are the first four nodes
+        const std::vector<uint> all = readElements(elements, basePath + ".ele", nTets, 10, base, nPos);
+        mesh.tets.resize(4 * nTets);
+        for (size_t t = 0; t < nTets; t++) std::copy_n(all.begin() + 10 * t, 4, mesh.tets.begin() + 4 * t);
+    }
+
+    mesh.edges = Topology::uniqueEdges(mesh.tets, 4);
+
+    // .face: <faces> <boundary marker>, then <index> <corners> ...
+    if (face.data) {
+        const TetGenFile faces(face, basePath + ".face");
+        const std::vector<uint> fileFaces = readElements(faces, basePath + ".face", faces.header()[0], 3, base, nPos);
+        buildSurface(mesh, &fileFaces);
+    } else {
+        buildSurface(mesh, nullptr);
+    }
+
+    if (!cachePath.empty() && !writeTet(cachePath, mesh, sourceSize, sourceTime)) {
+        std::cerr << "Could not write mesh cache: " << cachePath << std::endl;
+    }
+
+    return mesh;
+}
+
+TetMeshData MeshLoader::loadTet(const std::string &path) {
+    TetMeshData mesh;
+    TetHeader header;
+    if (!readTet(MappedFile(path), mesh, header)) throw std::runtime_error("Not a tetrahedral mesh: " + path);
+    return mesh;
+}
+
+void MeshLoader::saveTet(const std::string &path, const TetMeshData &mesh) {
+    if (!writeTet(path, mesh, 0, 0)) std::cerr << "Could not write tetrahedral mesh: " << path << std::endl;
+}
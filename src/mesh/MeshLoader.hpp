@@ -0,0 +1,49 @@
+// Loads triangle meshes from OFF files, with their edges, and tetrahedral meshes from TetGen files
+// To use:
+//    - MeshLoader::loadOFF(path, cachePath) gives a MeshData
+//    - MeshLoader::loadTetGen(basePath, cachePath) gives a TetMeshData, from basePath.node and basePath.ele
+//    - With a cache path, the result is stored there in binary and mapped in memory at the next loads,
+//      as long as the source files keep the same size and modification time
+// The text files are mapped in memory and their lines are parsed in parallel with std::from_chars.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct MeshData {
+    std::vector<glm::vec3> vertices;
+    std::vector<uint> indices;
+
+    std::vector<uint> edges; // unique edges, two indices each, the smallest first
+};
+
+struct TetMeshData {
+    std::vector<glm::vec3> pos;
+    std::vector<uint> tets;  // four indices of pos each
+    std::vector<uint> edges; // unique edges of the tetrahedra, two indices each, the smallest first
+
+    // Surface: triangles on its own vertices, oriented outwards, and the index in pos of each vertex
+    std::vector<uint> indices;
+    std::vector<uint> meshToPos;
+};
+
+namespace MeshLoader {
+
+// Throws std::runtime_error if the file cannot be read or has non triangular faces
+MeshData loadOFF(const std::string &path, const std::string &cachePath = "");
+
+// The surface is basePath.face if it exists (TetGen -f also lists the inner faces, they are dropped),
+// else the faces of the tetrahedra that are not shared. Indices may start at 0 or 1, as in TetGen.
+// Throws std::runtime_error if a file cannot be read or is not valid
+TetMeshData loadTetGen(const std::string &basePath, const std::string &cachePath = "");
+
+// Binary tetrahedral mesh, the format of the cache of loadTetGen, to ship converted assets
+TetMeshData loadTet(const std::string &path);
+void saveTet(const std::string &path, const TetMeshData &mesh);
+
+// data/cache/<file name><extension>
+std::string defaultCachePath(const std::string &path, const std::string &extension = ".mesh");
+
+} // namespace MeshLoader
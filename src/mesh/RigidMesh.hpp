@@ -7,12 +7,14 @@
 class RigidMesh : public Mesh {
 public:
     RigidMesh(const std::vector<glm::vec3> &pos, const std::vector<uint> &meshToPos, const std::vector<glm::vec3> &vertices, const std::vector<glm::vec3> &normals, const std::vector<uint> &indices)
-        : pos(pos), originalPos(pos), meshToPos(meshToPos), originalCOM(computeCOM(pos)), Mesh(vertices, normals, indices) {}
+        : originalPos(pos), meshToPos(meshToPos), originalCOM(computeCOM(pos)), Mesh(vertices, normals, indices) {}
 
     void applyTransform(const glm::mat4 &mat);
-    void shapeMatch(const std::vector<glm::vec3> &pos);
+    // Replaces pos by the closest rigid transform of the original shape, in place
+    void shapeMatch(std::vector<glm::vec3> &pos) const;
 
-    const std::vector<glm::vec3> &getPos() { return pos; }
+    // Positions of the original shape: the solver owns the current ones
+    const std::vector<glm::vec3> &getPos() { return originalPos; }
     const std::vector<uint> &getMeshToPos() const { return meshToPos; }
 
     std::vector<uint> generateEdges();
@@ -20,11 +22,10 @@ public:
     static std::shared_ptr<RigidMesh> createCube(int resolution, float w = 1.0f);
     static std::shared_ptr<RigidMesh> createFromOFF(const std::string &filePath);
 
-    static glm::vec3 computeCOM(const std::vector<glm::vec3> pos);
+    static glm::vec3 computeCOM(const std::vector<glm::vec3> &pos);
 
 private:
     std::vector<glm::vec3> originalPos;
-    std::vector<glm::vec3> pos;
     std::vector<uint> meshToPos;
     glm::vec3 originalCOM;
 };
\ No newline at end of file
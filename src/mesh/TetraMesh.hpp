@@ -11,15 +11,15 @@ public:
               const std::vector<glm::vec3> &vertices, const std::vector<glm::vec3> &normals, const std::vector<uint> &indices)
         : pos(pos), meshToPos(meshToPos), edges(edges), tets(tets), Mesh(vertices, normals, indices) {}
 
+    // Initial positions: the mesh follows the solver with setVertexSource(solver->getPos(), &getMeshToPos())
     const std::vector<glm::vec3> &getPos() { return pos; }
     const std::vector<uint> &getMeshToPos() const { return meshToPos; }
     const std::vector<uint> &getEdges() const { return edges; }
     const std::vector<uint> &getTets() const { return tets; }
 
-    void udpatePos(const std::vector<glm::vec3> &pos);
-
     static std::shared_ptr<TetraMesh> createCube(float w = 1.0f);
-    static std::shared_ptr<TetraMesh> createBunny();
+    // TetGen files basePath.node and basePath.ele (see MeshLoader::loadTetGen), cached in data/cache
+    static std::shared_ptr<TetraMesh> createFromTetGen(const std::string &basePath);
 
 private:
     std::vector<glm::vec3> pos;
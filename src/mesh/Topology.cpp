@@ -0,0 +1,166 @@
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+// Number of vertices used by the elements: largest index + 1
+uint vertexCount(const std::vector<uint> &elements) {
+    uint maxIndex = 0;
+    const long long n = elements.size();
+#pragma omp parallel for schedule(static) reduction(max : maxIndex)
+    for (long long i = 0; i < n; i++) {
+        maxIndex = std::max(maxIndex, elements[i]);
+    }
+    return n > 0 ? maxIndex + 1 : 0;
+}
+
+// Counting sort of n items by their bucket (a vertex): the values of bucket v are values[offsets[v], offsets[v + 1]),
+// in the order of the items
+template <typename Bucket, typename Value>
+void bucketSort(size_t n, uint nBuckets, Bucket bucket, Value value, std::vector<uint> &offsets, std::vector<uint> &values) {
+    offsets.assign(nBuckets + 1, 0);
+    for (size_t i = 0; i < n; i++) offsets[bucket(i) + 1]++;
+    for (uint v = 0; v < nBuckets; v++) offsets[v + 1] += offsets[v];
+
+    values.resize(n);
+    std::vector<uint> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < n; i++) values[fill[bucket(i)]++] = value(i);
+}
+
+} // namespace
+
+namespace Topology {
+
+std::vector<uint> uniqueEdges(const std::vector<uint> &elements, uint size) {
+    const size_t nElements = elements.size() / size;
+    const uint pairs = size * (size - 1) / 2;
+    const uint nVertices = vertexCount(elements);
+
+    // Corners (i, j) of each pair, in the order of the elements
+    std::vector<std::pair<uint, uint>> corners;
+    for (uint i = 0; i < size; i++) {
+        for (uint j = i + 1; j < size; j++) corners.emplace_back(i, j);
+    }
+    auto vertices = [&](size_t p) {
+        const uint *element = &elements[p / pairs * size];
+        const uint a = element[corners[p % pairs].first], b = element[corners[p % pairs].second];
+        return std::make_pair(std::min(a, b), std::max(a, b));
+    };
+
+    // Largest vertex of each pair, by smallest vertex
+    std::vector<uint> offsets, values;
+    bucketSort(nElements * pairs, nVertices, [&](size_t p) { return vertices(p).first; }, [&](size_t p) { return vertices(p).second; }, offsets, values);
+
+    // Each bucket is sorted and deduplicated on its own
+    std::vector<uint> counts(nVertices + 1, 0);
+#pragma omp parallel for schedule(dynamic, 256)
+    for (int v = 0; v < (int)nVertices; v++) {
+        const auto first = values.begin() + offsets[v], last = values.begin() + offsets[v + 1];
+        std::sort(first, last);
+        counts[v + 1] = std::unique(first, last) - first;
+    }
+    for (uint v = 0; v < nVertices; v++) counts[v + 1] += counts[v];
+
+    std::vector<uint> edges(2 * counts[nVertices]);
+#pragma omp parallel for schedule(static)
+    for (int v = 0; v < (int)nVertices; v++) {
+        for (uint k = 0; k < counts[v + 1] - counts[v]; k++) {
+            edges[2 * (counts[v] + k)] = v;
+            edges[2 * (counts[v] + k) + 1] = values[offsets[v] + k];
+        }
+    }
+
+    return edges;
+}
+
+void vertexElements(const std::vector<uint> &elements, uint size, uint nVertices, std::vector<uint> &offsets, std::vector<uint> &values) {
+    const uint nElements = elements.size() / size;
+
+    // Counting sort of the corners by vertex
+    offsets.assign(nVertices + 1, 0);
+    for (uint v : elements) offsets[v + 1]++;
+    for (uint v = 0; v < nVertices; v++) offsets[v + 1] += offsets[v];
+
+    values.resize(elements.size());
+    std::vector<uint> fill(offsets.begin(), offsets.end() - 1);
+    for (uint e = 0; e < nElements; e++) {
+        for (uint k = 0; k < size; k++) values[fill[elements[size * e + k]]++] = e;
+    }
+}
+
+void vertexNeighbours(const std::vector<uint> &edges, uint nVertices, std::vector<uint> &offsets, std::vector<uint> &neighbours) {
+    // Counting sort of both ends of every edge
+    offsets.assign(nVertices + 1, 0);
+    for (uint v : edges) offsets[v + 1]++;
+    for (uint v = 0; v < nVertices; v++) offsets[v + 1] += offsets[v];
+
+    neighbours.resize(edges.size());
+    std::vector<uint> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t e = 0; e + 1 < edges.size(); e += 2) {
+        const uint a = edges[e], b = edges[e + 1];
+        neighbours[fill[a]++] = b;
+        neighbours[fill[b]++] = a;
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int v = 0; v < (int)nVertices; v++) {
+        std::sort(neighbours.begin() + offsets[v], neighbours.begin() + offsets[v + 1]);
+    }
+}
+
+std::vector<uint> boundaryFaces(const std::vector<uint> &tets, std::vector<uint> *opposite) {
+    const size_t nFaces = tets.size() / 4 * 4;
+    const uint nVertices = vertexCount(tets);
+
+    // Face f is the one without corner f % 4 of its tetrahedron: its smallest corner, and the two others
+    std::vector<uint> smallest(nFaces);
+    std::vector<uint64_t> others(nFaces);
+#pragma omp parallel for schedule(static)
+    for (long long f = 0; f < (long long)nFaces; f++) {
+        uint sorted[3];
+        const uint *tet = &tets[f - f % 4];
+        for (uint k = 0, i = 0; k < 4; k++) {
+            if (k != f % 4) sorted[i++] = tet[k];
+        }
+        std::sort(sorted, sorted + 3);
+        smallest[f] = sorted[0];
+        others[f] = (uint64_t)sorted[1] << 32 | sorted[2];
+    }
+
+    std::vector<uint> offsets, faces;
+    bucketSort(nFaces, nVertices, [&](size_t f) { return smallest[f]; }, [](size_t f) { return f; }, offsets, faces);
+
+    // In a bucket, the copies of a face are next to each other once sorted by the two other corners
+    std::vector<uint8_t> single(nFaces, 0);
+#pragma omp parallel for schedule(dynamic, 256)
+    for (int v = 0; v < (int)nVertices; v++) {
+        const auto first = faces.begin() + offsets[v], last = faces.begin() + offsets[v + 1];
+        std::sort(first, last, [&](uint f, uint g) { return others[f] < others[g]; });
+
+        for (auto i = first; i != last;) {
+            auto j = i + 1;
+            while (j != last && others[*j] == others[*i]) j++;
+            if (j - i == 1) single[*i] = 1;
+            i = j;
+        }
+    }
+
+    // In the order of the tetrahedra
+    std::vector<uint> boundary;
+    if (opposite) opposite->clear();
+    for (size_t f = 0; f < nFaces; f++) {
+        if (!single[f]) continue;
+
+        const uint *tet = &tets[f - f % 4];
+        for (uint k = 0; k < 4; k++) {
+            if (k != f % 4) boundary.push_back(tet[k]);
+        }
+        if (opposite) opposite->push_back(tet[f % 4]);
+    }
+
+    return boundary;
+}
+
+} // namespace Topology
@@ -0,0 +1,33 @@
+// Connectivity of triangle and tetrahedral meshes
+// To use:
+//    - uniqueEdges(indices, 3) for triangles, uniqueEdges(tets, 4) for tetrahedra
+//    - vertexElements / vertexNeighbours give the elements or the neighbours of each vertex, as CSR arrays
+//    - boundaryFaces gives the surface of a tetrahedral mesh
+// Edges and faces are put in buckets by their smallest vertex with a counting sort, then each bucket is sorted
+// on its own in parallel: the results are sorted like with a std::set and do not depend on the number of threads.
+
+#pragma once
+
+#include <vector>
+#include <climits>
+#include <sys/types.h>
+
+namespace Topology {
+
+// No index
+constexpr uint NONE = UINT_MAX;
+
+// Unique edges of elements of the given size (2, 3 or 4), two indices each, the smallest first, sorted
+std::vector<uint> uniqueEdges(const std::vector<uint> &elements, uint size);
+
+// Elements around vertex v: elements[offsets[v], offsets[v + 1]), in increasing order
+void vertexElements(const std::vector<uint> &elements, uint size, uint nVertices, std::vector<uint> &offsets, std::vector<uint> &values);
+
+// Neighbours of vertex v through the edges: neighbours[offsets[v], offsets[v + 1]), sorted
+void vertexNeighbours(const std::vector<uint> &edges, uint nVertices, std::vector<uint> &offsets, std::vector<uint> &neighbours);
+
+// Faces of the tetrahedra that belong to a single tetrahedron, three indices each, with the fourth corner
+// of their tetrahedron in opposite (to orient them)
+std::vector<uint> boundaryFaces(const std::vector<uint> &tets, std::vector<uint> *opposite = nullptr);
+
+} // namespace Topology
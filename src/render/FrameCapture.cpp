@@ -0,0 +1,182 @@
+#include "FrameCapture.hpp"
+#include "stb_image_write.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <sys/wait.h>
+#include <filesystem>
+#include <iostream>
+
+FrameCapture::FrameCapture(Output output, const std::string &target, int fps) : output(output), target(target), fps(fps) {
+    for (Slot &slot : slots) {
+        glGenBuffers(1, &slot.pbo);
+    }
+
+    int nWorkers = 1;
+    if (output == Output::PNG) {
+        std::filesystem::create_directories(target);
+        nWorkers = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    } else {
+        // A command that exits early must not kill the program at the next write
+        struct sigaction ignore = {};
+        ignore.sa_handler = SIG_IGN;
+        sigaction(SIGPIPE, &ignore, &previousSigpipe);
+
+        pipe = popen(target.c_str(), "w");
+        if (!pipe) std::cerr << "Could not run: " << target << std::endl;
+    }
+
+    maxQueued = 2 * nWorkers + SLOTS;
+    for (int i = 0; i < nWorkers; i++) {
+        workers.emplace_back(&FrameCapture::work, this);
+    }
+}
+
+FrameCapture::~FrameCapture() {
+    // Read the frames still in the pixel buffers, oldest first
+    for (int k = 0; k < SLOTS; k++) {
+        Slot &slot = slots[(current + k) % SLOTS];
+        if (slot.fence) readBack(slot);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    if (output == Output::PIPE) closePipe();
+
+    for (Slot &slot : slots) {
+        glDeleteBuffers(1, &slot.pbo);
+    }
+}
+
+void FrameCapture::capture(int width, int height) {
+    if (!isOpen()) return;
+
+    Slot &slot = slots[current];
+
+    // The slot was filled SLOTS frames ago: the GPU is most likely done with it
+    if (slot.fence) readBack(slot);
+
+    const size_t size = (size_t)width * height * 3;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    if (slot.size != size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        slot.size = size;
+    }
+
+    // Returns at once: the copy to the buffer is done by the GPU
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.index = frameCount++;
+    slot.width = width;
+    slot.height = height;
+
+    current = (current + 1) % SLOTS;
+}
+
+void FrameCapture::readBack(Slot &slot) {
+    while (glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    Frame frame{slot.index, slot.width, slot.height, std::vector<unsigned char>(slot.size)};
+
+    // OpenGL gives the bottom row first: flip while copying
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    const unsigned char *src = static_cast<const unsigned char *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.size, GL_MAP_READ_BIT));
+    if (src) {
+        const size_t rowSize = (size_t)slot.width * 3;
+        for (int y = 0; y < slot.height; y++) {
+            std::memcpy(frame.pixels.data() + (slot.height - 1 - y) * rowSize, src + y * rowSize, rowSize);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (!src) return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    queueChanged.wait(lock, [&] { return queue.size() < maxQueued; });
+    queue.push_back(std::move(frame));
+    lock.unlock();
+    queueChanged.notify_all();
+}
+
+void FrameCapture::work() {
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        queueChanged.wait(lock, [&] { return stopping || !queue.empty(); });
+        if (queue.empty()) return;
+
+        Frame frame = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        queueChanged.notify_all();
+
+        write(frame);
+    }
+}
+
+void FrameCapture::write(const Frame &frame) {
+    if (output == Output::PIPE) {
+        writeY4M(frame);
+        return;
+    }
+
+    const std::string filename = target + "/" + std::to_string(frame.index) + ".png";
+    if (!stbi_write_png(filename.c_str(), frame.width, frame.height, 3, frame.pixels.data(), frame.width * 3)) {
+        std::cerr << "Failed to save " << filename << std::endl;
+    }
+}
+
+void FrameCapture::writeY4M(const Frame &frame) {
+    if (!isOpen()) return;
+
+    // The stream has one size, given by the first frame
+    if (streamWidth == 0) {
+        fprintf(pipe, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", frame.width, frame.height, fps);
+        streamWidth = frame.width;
+        streamHeight = frame.height;
+    }
+    if (frame.width != streamWidth || frame.height != streamHeight) {
+        std::cerr << "Frame " << frame.index << " skipped: the window was resized during the capture" << std::endl;
+        return;
+    }
+
+    // BT.601, limited range, no chroma subsampling
+    const size_t n = (size_t)frame.width * frame.height;
+    std::vector<unsigned char> planes(3 * n);
+    for (size_t i = 0; i < n; i++) {
+        const float r = frame.pixels[3 * i], g = frame.pixels[3 * i + 1], b = frame.pixels[3 * i + 2];
+        planes[i] = (unsigned char)(16.5f + (65.738f * r + 129.057f * g + 25.064f * b) / 256.0f);
+        planes[n + i] = (unsigned char)(128.5f + (-37.945f * r - 74.494f * g + 112.439f * b) / 256.0f);
+        planes[2 * n + i] = (unsigned char)(128.5f + (112.439f * r - 94.154f * g - 18.285f * b) / 256.0f);
+    }
+
+    // The header is checked with the first frame. If the command exited (EPIPE), the next frames are dropped.
+    if (fputs("FRAME\n", pipe) == EOF || fwrite(planes.data(), 1, planes.size(), pipe) != planes.size() || fflush(pipe) != 0) {
+        std::cerr << "Could not write frame " << frame.index << " to: " << target << " (" << std::strerror(errno) << "), the capture is stopped" << std::endl;
+        pipeFailed = true;
+    }
+}
+
+void FrameCapture::closePipe() {
+    if (pipe) {
+        const int status = pclose(pipe);
+        if (status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "The video encoder failed: " << target << std::endl;
+        }
+    }
+
+    sigaction(SIGPIPE, &previousSigpipe, nullptr);
+}
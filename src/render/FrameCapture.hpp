@@ -0,0 +1,81 @@
+// Saves the frames drawn in the window, without stalling the rendering
+// To use:
+//    - Create it with a directory (one PNG per frame) or with a shell command reading a Y4M stream on its input
+//    - capture after the scene is drawn, every frame to record
+//    - destroy it to finish: the frames still in flight are written first
+// The pixels are read into SLOTS pixel buffer objects in turn, and copied back (flipped) SLOTS - 1 frames later,
+// once the GPU is done. PNG encoding runs on a pool of threads; the Y4M stream is written by one thread, in order.
+// SIGPIPE is ignored while a pipe is open: if the command exits, isOpen becomes false and the frames are dropped.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <atomic>
+#include <csignal>
+
+class FrameCapture {
+public:
+    enum class Output { PNG, PIPE };
+
+    static constexpr int SLOTS = 3;
+
+    // PNG: target is a directory, frames are saved as target/<frame>.png
+    // PIPE: target is a command run with popen, e.g. "ffmpeg -f yuv4mpegpipe -i - out.mp4"
+    FrameCapture(Output output, const std::string &target, int fps = 60);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture &) = delete;
+    FrameCapture &operator=(const FrameCapture &) = delete;
+
+    void capture(int width, int height);
+
+    int getFrameCount() const { return frameCount; }
+    bool isOpen() const { return output == Output::PNG || (pipe != nullptr && !pipeFailed); }
+
+private:
+    struct Frame {
+        int index;
+        int width, height;
+        std::vector<unsigned char> pixels; // RGB, top row first
+    };
+
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        size_t size = 0;
+        int index, width, height;
+    };
+
+    Output output;
+    std::string target;
+    int fps;
+    FILE *pipe = nullptr;
+    int streamWidth = 0, streamHeight = 0; // written by the only worker of a pipe
+    std::atomic<bool> pipeFailed{false};
+    struct sigaction previousSigpipe;
+
+    Slot slots[SLOTS];
+    int current = 0;
+    int frameCount = 0;
+
+    // Encoding queue, bounded so that a slow encoder slows the capture down instead of filling the memory
+    std::deque<Frame> queue;
+    std::mutex mutex;
+    std::condition_variable queueChanged;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+    size_t maxQueued;
+
+    void readBack(Slot &slot);
+    void work();
+    void write(const Frame &frame);
+    void writeY4M(const Frame &frame);
+    void closePipe();
+};
@@ -0,0 +1,125 @@
+#include "ParticleRenderer.hpp"
+#include "utils/utils.hpp"
+
+#include <algorithm>
+
+ParticleRenderer::ParticleRenderer(float radius, Mode mode) : mode(mode), radius(radius) {
+    sphere = Mesh::createSphere(1.0f, 16);
+}
+
+void ParticleRenderer::createGL() {
+    if (instanceVBO) return;
+
+    impostorProgram = std::make_unique<ShaderProgram>("shaders/impostor_vert.glsl", "shaders/impostor_frag.glsl");
+    glGenBuffers(1, &instanceVBO);
+
+    // The instance positions go to attribute 3 of the sphere mesh...
+    glBindVertexArray(sphere->getVAO());
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)0);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(3);
+
+    // ...and of the impostor quads, whose corners come from gl_VertexID
+    glGenVertexArrays(1, &impostorVAO);
+    glBindVertexArray(impostorVAO);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)0);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(3);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+ParticleRenderer::~ParticleRenderer() {
+    if (!instanceVBO) return;
+    glDeleteVertexArrays(1, &impostorVAO);
+    glDeleteBuffers(1, &instanceVBO);
+}
+
+void ParticleRenderer::cull(const std::vector<glm::vec3> &pos, const glm::mat4 &viewProj) {
+    // Frustum planes from the rows of the view projection matrix, not normalized:
+    // the radius is scaled by the length of each normal instead
+    const glm::mat4 m = glm::transpose(viewProj);
+    const glm::vec4 planes[6] = {m[3] + m[0], m[3] - m[0], m[3] + m[1], m[3] - m[1], m[3] + m[2], m[3] - m[2]};
+    float margins[6];
+    for (int k = 0; k < 6; k++) margins[k] = -radius * glm::length(glm::vec3(planes[k]));
+
+    auto inside = [&](const glm::vec3 &p) {
+        for (int k = 0; k < 6; k++) {
+            if (glm::dot(glm::vec3(planes[k]), p) + planes[k].w < margins[k]) return false;
+        }
+        return true;
+    };
+
+    // Compaction by blocks: count, prefix sum, then copy
+    const int n = pos.size();
+    const int blockSize = 4096;
+    const int nBlocks = (n + blockSize - 1) / blockSize;
+    std::vector<uint> offsets(nBlocks + 1, 0);
+
+#pragma omp parallel for schedule(static)
+    for (int b = 0; b < nBlocks; b++) {
+        uint count = 0;
+        for (int i = b * blockSize; i < std::min(n, (b + 1) * blockSize); i++) {
+            count += inside(pos[i]);
+        }
+        offsets[b + 1] = count;
+    }
+
+    for (int b = 0; b < nBlocks; b++) offsets[b + 1] += offsets[b];
+    visible.resize(offsets[nBlocks]);
+
+#pragma omp parallel for schedule(static)
+    for (int b = 0; b < nBlocks; b++) {
+        uint k = offsets[b];
+        for (int i = b * blockSize; i < std::min(n, (b + 1) * blockSize); i++) {
+            if (inside(pos[i])) visible[k++] = pos[i];
+        }
+    }
+}
+
+void ParticleRenderer::draw(ShaderProgram &shaderProgram, const std::vector<glm::vec3> &pos, const glm::vec3 &color) {
+    createGL();
+
+    glm::mat4 view, projection;
+    shaderProgram.get("view", view);
+    shaderProgram.get("projection", projection);
+
+    cull(pos, projection * view);
+    if (visible.empty()) return;
+
+    // The buffer is orphaned every frame, the driver does not wait for the previous draw
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, visible.size() * sizeof(glm::vec3), visible.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (mode == Mode::MESH) {
+        shaderProgram.use();
+        shaderProgram.set("objectColor", color);
+        shaderProgram.set("model", utils::getScale(radius));
+
+        glBindVertexArray(sphere->getVAO());
+        glDrawElementsInstanced(GL_TRIANGLES, sphere->getIndexCount(), GL_UNSIGNED_INT, 0, visible.size());
+        glBindVertexArray(0);
+        return;
+    }
+
+    glm::vec3 viewPos, lightDir, lightColor;
+    shaderProgram.get("viewPos", viewPos);
+    shaderProgram.get("lightDir", lightDir);
+    shaderProgram.get("lightColor", lightColor);
+
+    impostorProgram->use();
+    impostorProgram->set("view", view);
+    impostorProgram->set("projection", projection);
+    impostorProgram->set("radius", radius);
+    impostorProgram->set("viewPos", viewPos);
+    impostorProgram->set("lightDir", lightDir);
+    impostorProgram->set("lightColor", lightColor);
+    impostorProgram->set("objectColor", color);
+
+    glBindVertexArray(impostorVAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, visible.size());
+    glBindVertexArray(0);
+}
@@ -0,0 +1,45 @@
+// Draws many spheres of the same radius in one draw call
+// To use:
+//    - Create it once per scene, with the radius of the particles
+//    - draw with the shader program of the scene: its camera and light are reused
+// Two modes:
+//    - MESH: instanced sphere mesh, with the shader program of the scene
+//    - IMPOSTOR: one ray cast quad per particle, exact spheres for 4 vertices each
+// The particles outside of the view frustum are removed on the CPU before the upload.
+// The GL objects are created at the first draw, so that scenes can be built on another thread.
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+#include "render/ShaderProgram.hpp"
+#include "mesh/Mesh.hpp"
+
+class ParticleRenderer {
+public:
+    enum class Mode { MESH, IMPOSTOR };
+
+    ParticleRenderer(float radius, Mode mode = Mode::IMPOSTOR);
+    ~ParticleRenderer();
+
+    void draw(ShaderProgram &shaderProgram, const std::vector<glm::vec3> &pos, const glm::vec3 &color);
+
+    void setRadius(float radius) { this->radius = radius; }
+    Mode mode;
+
+    uint getVisibleCount() const { return visible.size(); }
+
+private:
+    float radius;
+
+    std::shared_ptr<Mesh> sphere;
+    std::unique_ptr<ShaderProgram> impostorProgram;
+    GLuint impostorVAO = 0;
+    GLuint instanceVBO = 0;
+
+    std::vector<glm::vec3> visible;
+
+    void createGL();
+    void cull(const std::vector<glm::vec3> &pos, const glm::mat4 &viewProj);
+};
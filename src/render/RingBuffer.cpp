@@ -0,0 +1,57 @@
+#include "RingBuffer.hpp"
+
+#include <algorithm>
+
+RingBuffer::RingBuffer(size_t slotSize) : slotSize(std::max<size_t>(slotSize, 16)) {
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    if (GLAD_GL_ARB_buffer_storage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, SLOTS * this->slotSize, nullptr, flags);
+        mapped = static_cast<char *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, SLOTS * this->slotSize, flags));
+    }
+
+    if (!mapped) {
+        glBufferData(GL_ARRAY_BUFFER, SLOTS * this->slotSize, nullptr, GL_STREAM_DRAW);
+        staging.resize(this->slotSize);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+RingBuffer::~RingBuffer() {
+    for (GLsync fence : fences) {
+        if (fence) glDeleteSync(fence);
+    }
+    // Deleting the buffer also unmaps it
+    glDeleteBuffers(1, &buffer);
+}
+
+void *RingBuffer::advance() {
+    // Every draw reading the current region has been issued: the fence is signaled once they are done
+    if (slot >= 0) {
+        if (fences[slot]) glDeleteSync(fences[slot]);
+        fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    slot = (slot + 1) % SLOTS;
+
+    // Only waits if the GPU is more than SLOTS - 1 frames late
+    if (fences[slot]) {
+        while (glClientWaitSync(fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+        glDeleteSync(fences[slot]);
+        fences[slot] = nullptr;
+    }
+
+    return mapped ? mapped + slot * slotSize : staging.data();
+}
+
+void RingBuffer::commit() {
+    // Coherent mapping: nothing to flush
+    if (mapped) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferSubData(GL_ARRAY_BUFFER, slot * slotSize, slotSize, staging.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
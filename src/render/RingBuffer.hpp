@@ -0,0 +1,41 @@
+// GPU buffer split in SLOTS regions written in turn by the CPU, for data that changes every frame
+// To use:
+//    - advance gives the memory of the next region, once the GPU has finished reading it
+//    - write the whole region, then commit
+//    - draw from getSlot() * slotSize
+// With GL_ARB_buffer_storage the buffer is persistently mapped and written in place,
+// otherwise each region is uploaded with glBufferSubData.
+
+#pragma once
+
+#include <glad/gl.h>
+#include <vector>
+#include <cstddef>
+
+class RingBuffer {
+public:
+    static constexpr int SLOTS = 3;
+
+    RingBuffer(size_t slotSize);
+    ~RingBuffer();
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    void *advance();
+    void commit();
+
+    GLuint getBuffer() const { return buffer; }
+    int getSlot() const { return slot; }
+    size_t getSlotSize() const { return slotSize; }
+    bool isPersistent() const { return mapped != nullptr; }
+
+private:
+    GLuint buffer;
+    size_t slotSize;
+    int slot = -1;
+    GLsync fences[SLOTS] = {};
+
+    char *mapped = nullptr;
+    std::vector<char> staging; // without persistent mapping
+};
@@ -54,22 +54,30 @@ uint ShaderProgram::compileShader(const std::string &source, GLenum type) {
     return shader;
 }
 
+GLint ShaderProgram::getLocation(const std::string &name) {
+    auto it = locations.find(name);
+    if (it == locations.end()) {
+        it = locations.emplace(name, glGetUniformLocation(programID, name.c_str())).first;
+    }
+    return it->second;
+}
+
 void ShaderProgram::setArray(const std::string &array, uint index, const std::string &name, int i) {
     std::string fullName = array + "[" + std::to_string(index) + "]." + name;
-    glUniform1i(glGetUniformLocation(programID, fullName.c_str()), i);
+    glUniform1i(getLocation(fullName), i);
 }
 
 void ShaderProgram::setArray(const std::string &array, uint index, const std::string &name, float val) {
     std::string fullName = array + "[" + std::to_string(index) + "]." + name;
-    glUniform1f(glGetUniformLocation(programID, fullName.c_str()), val);
+    glUniform1f(getLocation(fullName), val);
 }
 
 void ShaderProgram::setArray(const std::string &array, uint index, const std::string &name, const glm::vec3 &vec) {
     std::string fullName = array + "[" + std::to_string(index) + "]." + name;
-    glUniform3fv(glGetUniformLocation(programID, fullName.c_str()), 1, glm::value_ptr(vec));
+    glUniform3fv(getLocation(fullName), 1, glm::value_ptr(vec));
 }
 
 void ShaderProgram::setArray(const std::string &array, uint index, const std::string &name, const glm::mat4 &mat) {
     std::string fullName = array + "[" + std::to_string(index) + "]." + name;
-    glUniformMatrix4fv(glGetUniformLocation(programID, fullName.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+    glUniformMatrix4fv(getLocation(fullName), 1, GL_FALSE, glm::value_ptr(mat));
 }
@@ -8,6 +8,7 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 
 class ShaderProgram {
 public:
@@ -20,11 +21,15 @@ public:
 
     void use() { glUseProgram(programID); };
 
-    void set(const GLchar *name, int i) { glUniform1i(glGetUniformLocation(programID, name), i); };
-    void set(const GLchar *name, bool b) { glUniform1i(glGetUniformLocation(programID, name), b); };
-    void set(const GLchar *name, float val) { glUniform1f(glGetUniformLocation(programID, name), val); };
-    void set(const GLchar *name, const glm::vec3 &vec) { glUniform3fv(glGetUniformLocation(programID, name), 1, glm::value_ptr(vec)); };
-    void set(const GLchar *name, const glm::mat4 &mat) { glUniformMatrix4fv(glGetUniformLocation(programID, name), 1, GL_FALSE, glm::value_ptr(mat)); };
+    void set(const GLchar *name, int i) { glUniform1i(getLocation(name), i); };
+    void set(const GLchar *name, bool b) { glUniform1i(getLocation(name), b); };
+    void set(const GLchar *name, float val) { glUniform1f(getLocation(name), val); };
+    void set(const GLchar *name, const glm::vec3 &vec) { glUniform3fv(getLocation(name), 1, glm::value_ptr(vec)); };
+    void set(const GLchar *name, const glm::mat4 &mat) { glUniformMatrix4fv(getLocation(name), 1, GL_FALSE, glm::value_ptr(mat)); };
+
+    // Read back the value of a uniform
+    void get(const GLchar *name, glm::vec3 &vec) { glGetUniformfv(programID, getLocation(name), glm::value_ptr(vec)); };
+    void get(const GLchar *name, glm::mat4 &mat) { glGetUniformfv(programID, getLocation(name), glm::value_ptr(mat)); };
 
     void setArray(const std::string &array, uint index, const std::string &name, int i);
     void setArray(const std::string &array, uint index, const std::string &name, float i);
@@ -36,6 +41,10 @@ public:
 
 protected:
     GLuint programID;
+
+    // Uniform locations are looked up once per name
+    std::unordered_map<std::string, GLint> locations;
+    GLint getLocation(const std::string &name);
 };
 
 #endif // SHADER_PROGRAM_HPP
\ No newline at end of file
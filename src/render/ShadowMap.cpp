@@ -42,9 +42,16 @@ void ShadowMap::allocate() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+bool ShadowMap::needsRender(uint64_t version) {
+    if (version == renderedVersion) return false;
+    renderedVersion = version;
+    return true;
+}
+
 void ShadowMap::beginRender() {
     shaderProgram.use();
     glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
 
     glViewport(0, 0, width, height);
     glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
@@ -57,13 +64,13 @@ void ShadowMap::addObject(std::shared_ptr<Mesh> mesh, glm::mat4 modelMat) {
     shaderProgram.set("lightMVP", depthMVP * modelMat);
 
     glBindVertexArray(mesh->getVAO());
-    glDrawElements(GL_TRIANGLES, mesh->getIndexCount(), GL_UNSIGNED_INT, 0);
+    mesh->drawElements();
     glBindVertexArray(0);
 }
 
 void ShadowMap::endRender() {
     // Reset viewport
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
     glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glCullFace(GL_BACK);
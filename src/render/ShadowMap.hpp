@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include "render/ShaderProgram.hpp"
 #include "mesh/Mesh.hpp"
@@ -16,6 +17,9 @@ private:
     int width, height;
 
     GLint viewport[4];
+    GLint framebuffer; // restored after the pass, the scene may not be drawn to the window
+
+    uint64_t renderedVersion = 0;
 
     void allocate();
 
@@ -23,6 +27,10 @@ public:
     ShadowMap(std::string vertexShader, std::string fragShader, const glm::vec3 &lightDir, const Camera &cam, int width, int height);
     ~ShadowMap();
 
+    // False if the casters were last rendered at this version (see Solver::getVersion), true and remembered otherwise
+    bool needsRender(uint64_t version);
+    void invalidate() { renderedVersion = 0; }
+
     void beginRender();
     void addObject(std::shared_ptr<Mesh> mesh, glm::mat4 modelMat = glm::mat4(1.0));
     void endRender();
@@ -11,22 +11,31 @@ public:
     bool bendingConstraints;
     bool collisionConstraint;
     bool spawnVertical;
+    bool selfCollision;
+    bool terrain;
     float alphaDistance = 1e-8;
     float alphaBending = 1e-8;
     float alphaPlaneCollision = 1e-8;
     float alphaCollision = 1e-8;
 
-    Cloth(int w = 64, int h = 64, float distance = 0.05f, bool bendingConstraints = true, bool collisionConstraint = false, bool spawnVertical = false)
-        : w(w), h(h), distance(distance), bendingConstraints(bendingConstraints), collisionConstraint(collisionConstraint), spawnVertical(spawnVertical) {
+    Cloth(int w = 64, int h = 64, float distance = 0.05f, bool bendingConstraints = true, bool collisionConstraint = false, bool spawnVertical = false, bool selfCollision = false, bool terrain = false)
+        : w(w), h(h), distance(distance), bendingConstraints(bendingConstraints), collisionConstraint(collisionConstraint), spawnVertical(spawnVertical), selfCollision(selfCollision), terrain(terrain) {
+        Arena::Scope scope(arena);
 
         std::vector<glm::vec3> pos;
         std::vector<Constraint *> constraints;
 
-        plane = Mesh::createPlane();
-        plane->applyTransform(utils::getTranslateY(-1.5) * utils::getScale(500));
+        // At most 4 distance and 2 bending constraints per particle
+        constraints.reserve(6 * w * h);
+        arena.reserve(6 * w * h * Arena::objectSize<DistanceConstraint>(2 * sizeof(uint)));
 
-        const std::vector<glm::vec3> &v = plane->getVertices();
-        semiPlane = new SemiPlane(v[0], v[1], v[2]);
+        if (terrain) {
+            heightfield = Heightfield::createFromPGM("data/terrain/hills.pgm", 0.1f, -1.95f, -1.05f);
+            plane = Mesh::createHeightfield(*heightfield);
+        } else {
+            plane = Mesh::createPlane();
+            plane->applyTransform(utils::getTranslateY(-1.5) * utils::getScale(500));
+        }
 
         for (int y = 0; y < h; y++) {
             for (int x = 0; x < w; x++) {
@@ -45,9 +54,6 @@ public:
                     constraints.push_back(new DistanceConstraint((y + 1) * w + x, y * w + (x + 1), distance * sqrt(2), &alphaDistance));
                 }
 
-                // Collision
-                constraints.push_back(new SemiPlaneConstraint(y * w + x, semiPlane, &alphaPlaneCollision, 0.01));
-
                 // Bending
                 if (bendingConstraints) {
                     // if (x != w - 1 && y < h - 2)
@@ -68,6 +74,14 @@ public:
 
         solver = new Solver(pos, constraints);
 
+        if (terrain) {
+            solver->getColliders().addHeightfield(heightfield, 0.01);
+        } else {
+            const std::vector<glm::vec3> &v = plane->getVertices();
+            solver->getColliders().addPlane(SemiPlane(v[0], v[1], v[2]), 0.01);
+        }
+        solver->getColliders().setCompliance(&alphaPlaneCollision);
+
         if (!spawnVertical) {
             solver->addFixedPoint(0, pos[0]);         // + glm::vec3(0.5, 0, 0));
             solver->addFixedPoint(w - 1, pos[w - 1]); // - glm::vec3(0.5, 0, 0));
@@ -75,29 +89,22 @@ public:
 
         solver->activateGlobalCollision(distance, &alphaPlaneCollision);
         solver->setGlobalCollision(collisionConstraint);
+
+        solver->activateSelfCollision(meshFront->getIndices(), 0.2f * distance, &alphaCollision);
+
+        followSolver(*meshFront, *meshBack);
+        solver->setSelfCollision(selfCollision);
     }
 
-    Cloth(const Cloth &scene) : Cloth(scene.w, scene.h, scene.distance, scene.bendingConstraints, scene.collisionConstraint, scene.spawnVertical) {
+    Cloth(const Cloth &scene) : Cloth(scene.w, scene.h, scene.distance, scene.bendingConstraints, scene.collisionConstraint, scene.spawnVertical, scene.selfCollision, scene.terrain) {
         this->alphaCollision = scene.alphaCollision;
         this->alphaPlaneCollision = scene.alphaPlaneCollision;
         this->alphaDistance = scene.alphaDistance;
         this->alphaBending = scene.alphaBending;
     }
 
-    ~Cloth() override {
-        delete semiPlane;
-    }
-
     void draw(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap) override {
-        meshFront->setVertices(solver->getPos());
-        meshFront->updateNormals();
-        meshBack->setVertices(solver->getPos());
-        meshBack->updateNormals();
-
-        shadowMap.beginRender();
-        shadowMap.addObject(meshFront);
-        shadowMap.addObject(meshBack);
-        shadowMap.endRender();
+        updateCloth(meshFront, meshBack, shadowMap);
 
         shaderProgram.use();
         meshFront->draw(shaderProgram, glm::vec3(0.7), glm::mat4(1.0));
@@ -115,10 +122,18 @@ public:
             solver->setGlobalCollision(collisionConstraint);
         }
 
+        if (ImGui::Checkbox("Use triangle self collision", &selfCollision)) {
+            solver->setSelfCollision(selfCollision);
+        }
+
         if (ImGui::Checkbox("Spawn vertical", &spawnVertical)) {
             changed = true;
         }
 
+        if (ImGui::Checkbox("Uneven terrain", &terrain)) {
+            changed = true;
+        }
+
         int newW = w;
         if (ImGui::InputInt("Width", &newW)) {
             if (newW < 1) {
@@ -165,5 +180,5 @@ private:
     std::shared_ptr<Mesh> meshFront;
     std::shared_ptr<Mesh> meshBack;
     std::shared_ptr<Mesh> plane;
-    SemiPlane *semiPlane;
+    std::shared_ptr<Heightfield> heightfield;
 };
\ No newline at end of file
@@ -2,12 +2,16 @@
 #include "Scene.hpp"
 #include "utils/utils.hpp"
 #include "imgui.h"
+#include "utils/SDF.hpp"
+#include <array>
 
 class ClothDrop : public Scene {
 public:
     // Parameters
     int w;
     bool collisionConstraint;
+    bool selfCollision;
+    int obstacleIdx;
     float alphaDistance = 1e-8;
     float alphaBending = 1e-8;
     float alphaPlaneCollision = 1e-8;
@@ -15,10 +19,18 @@ public:
 
     bool drawLines = false;
 
-    ClothDrop(int w = 64, bool collisionConstraint = false)
-        : w(w), collisionConstraint(collisionConstraint) {
-
-        sphere = Mesh::createSphere(1.0f, 32);
+    ClothDrop(int w = 64, bool collisionConstraint = false, bool selfCollision = false, int obstacleIdx = 0)
+        : w(w), collisionConstraint(collisionConstraint), selfCollision(selfCollision), obstacleIdx(obstacleIdx) {
+        Arena::Scope scope(arena);
+
+        if (obstacleIdx == 0) {
+            obstacle = Mesh::createSphere(1.0f, 32);
+        } else if (obstacleIdx == 1) {
+            obstacle = Mesh::createFromOFF("data/mesh/bunny.off");
+            obstacle->applyTransform(utils::getScale(15));
+        } else if (obstacleIdx == 2) {
+            obstacle = Mesh::createFromOFF("data/mesh/monkey.off");
+        }
 
         std::vector<glm::vec3> pos;
         std::vector<Constraint *> constraints;
@@ -61,18 +73,30 @@ public:
         meshFront = Mesh::createPlane(pos, w, w);
         meshBack = Mesh::createPlane(pos, w, w, true);
 
-        auto &indices = meshFront->getIndices();
-        for (int i = 0; i < indices.size(); i += 3) {
-            constraints.push_back(new SphereTriCollisionConstraint(indices[i], indices[i + 1], indices[i + 2], &sphereCenter, sphereRad + 0.05, &alphaPlaneCollision));
+        solver = new Solver(pos, constraints, 0.01 / (w * w));
+
+        if (obstacleIdx == 0) {
+            // Only the triangles near the sphere are turned into collision constraints each step
+            solver->activateTriangleCollision(meshFront->getIndices());
+            solver->addSphereObstacle(&sphereCenter, sphereRad + 0.05, &alphaPlaneCollision);
+        } else {
+            // Static meshes are voxelized once, then cached
+            std::shared_ptr<SDF> sdf = SDF::createFromMesh(obstacle->getVertices(), obstacle->getIndices(), 0.04f, 3,
+                                                           std::string("data/cache/") + names[obstacleIdx] + ".sdf");
+            solver->getColliders().addSDF(sdf, 0.05f);
+            solver->getColliders().setCompliance(&alphaPlaneCollision);
         }
 
-        solver = new Solver(pos, constraints, 0.01 / (w * w));
+        solver->activateSelfCollision(meshFront->getIndices(), 0.2f * distance, &alphaCollision);
+
+        followSolver(*meshFront, *meshBack);
+        solver->setSelfCollision(selfCollision);
 
         // solver->activateGlobalCollision(distance, &alphaPlaneCollision);
         // solver->setGlobalCollision(collisionConstraint);
     }
 
-    ClothDrop(const ClothDrop &scene) : ClothDrop(scene.w, scene.collisionConstraint) {
+    ClothDrop(const ClothDrop &scene) : ClothDrop(scene.w, scene.collisionConstraint, scene.selfCollision, scene.obstacleIdx) {
         this->alphaCollision = scene.alphaCollision;
         this->alphaPlaneCollision = scene.alphaPlaneCollision;
         this->alphaDistance = scene.alphaDistance;
@@ -85,15 +109,7 @@ public:
     }
 
     void draw(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap) override {
-        meshFront->setVertices(solver->getPos());
-        meshFront->updateNormals();
-        meshBack->setVertices(solver->getPos());
-        meshBack->updateNormals();
-
-        shadowMap.beginRender();
-        shadowMap.addObject(meshFront);
-        shadowMap.addObject(meshBack);
-        shadowMap.endRender();
+        updateCloth(meshFront, meshBack, shadowMap);
 
         shaderProgram.use();
         shadowMap.sendShadowMap(shaderProgram);
@@ -107,7 +123,7 @@ public:
             glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         }
 
-        sphere->draw(shaderProgram, glm::vec3(1.0, 0.9, 0.2), glm::mat4(1.0));
+        obstacle->draw(shaderProgram, glm::vec3(1.0, 0.9, 0.2), glm::mat4(1.0));
     }
 
     bool showUI() override {
@@ -117,6 +133,10 @@ public:
         //     solver->setGlobalCollision(collisionConstraint);
         // }
 
+        if (ImGui::Checkbox("Use triangle self collision", &selfCollision)) {
+            solver->setSelfCollision(selfCollision);
+        }
+
         int newW = w;
         if (ImGui::InputInt("Width", &newW)) {
             if (newW < 1) {
@@ -128,6 +148,10 @@ public:
             }
         }
 
+        if (ImGui::Combo("Obstacle", &obstacleIdx, names.data(), names.size())) {
+            changed = true;
+        }
+
         ImGui::Checkbox("Draw lines", &drawLines);
 
         return changed;
@@ -142,8 +166,10 @@ public:
 private:
     std::shared_ptr<Mesh> meshFront;
     std::shared_ptr<Mesh> meshBack;
-    std::shared_ptr<Mesh> sphere;
+    std::shared_ptr<Mesh> obstacle;
 
     glm::vec3 sphereCenter = glm::vec3(0);
     float sphereRad = 1.0f;
+
+    static constexpr std::array<const char *, 3> names = {"sphere", "bunny", "monkey"};
 };
\ No newline at end of file
@@ -18,19 +18,19 @@ public:
     float cylinderDist;
     float cylinderTheta;
 
+    bool selfCollision;
+
     bool drawLines = false;
 
-    ClothTurn(int w = 16, float cylinderDist = 1, float cylinderTheta = 0)
-        : w(w), cylinderDist(cylinderDist), cylinderTheta(cylinderTheta) {
+    ClothTurn(int w = 16, float cylinderDist = 1, float cylinderTheta = 0, bool selfCollision = false)
+        : w(w), cylinderDist(cylinderDist), cylinderTheta(cylinderTheta), selfCollision(selfCollision) {
+        Arena::Scope scope(arena);
 
         int h = 64;
 
         cylinderMesh1 = Mesh::createCylinder(1.0f, cylRad);
         cylinderMesh2 = Mesh::createCylinder(1.0f, cylRad);
 
-        cylinder1 = new Cylinder({1, 0, 0}, {0, cylinderDist / 2, 0}, cylRad + 0.02);
-        cylinder2 = new Cylinder({1, 0, 0}, {0, -cylinderDist / 2, 0}, cylRad + 0.02);
-
         std::vector<glm::vec3> pos;
         std::vector<Constraint *> constraints;
 
@@ -54,10 +54,6 @@ public:
                     constraints.push_back(new DistanceConstraint((y + 1) % h * w + x, y * w + (x + 1), distance * sqrt(2), &alphaDistance));
                 }
 
-                // Collision
-                constraints.push_back(new CylinderCollisionConstraint(y * w + x, cylinder1, &alphaPlaneCollision));
-                constraints.push_back(new CylinderCollisionConstraint(y * w + x, cylinder2, &alphaPlaneCollision));
-
                 // Bending
                 // int range = 2;
                 // constraints.push_back(new DistanceConstraint(y * w + x, (y + range) % h * w + x, distance, &alphaDistance));
@@ -78,10 +74,19 @@ public:
 
         solver = new Solver(pos, constraints, 0.01 / (w * h));
 
+        solver->getColliders().addCylinder(Cylinder({1, 0, 0}, {0, cylinderDist / 2, 0}, cylRad + 0.02));
+        solver->getColliders().addCylinder(Cylinder({1, 0, 0}, {0, -cylinderDist / 2, 0}, cylRad + 0.02));
+        solver->getColliders().setCompliance(&alphaPlaneCollision);
+
         solver->activateGlobalCollision(distance, &alphaPlaneCollision);
+
+        solver->activateSelfCollision(meshFront->getIndices(), 0.2f * distance, &alphaCollision);
+
+        followSolver(*meshFront, *meshBack);
+        solver->setSelfCollision(selfCollision);
     }
 
-    ClothTurn(const ClothTurn &scene) : ClothTurn(scene.w) {
+    ClothTurn(const ClothTurn &scene) : ClothTurn(scene.w, 1, 0, scene.selfCollision) {
         this->alphaCollision = scene.alphaCollision;
         this->alphaPlaneCollision = scene.alphaPlaneCollision;
         this->alphaDistance = scene.alphaDistance;
@@ -94,15 +99,7 @@ public:
     }
 
     void draw(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap) override {
-        meshFront->setVertices(solver->getPos());
-        meshFront->updateNormals();
-        meshBack->setVertices(solver->getPos());
-        meshBack->updateNormals();
-
-        shadowMap.beginRender();
-        shadowMap.addObject(meshFront);
-        shadowMap.addObject(meshBack);
-        shadowMap.endRender();
+        updateCloth(meshFront, meshBack, shadowMap);
 
         shaderProgram.use();
         shadowMap.sendShadowMap(shaderProgram);
@@ -137,15 +134,21 @@ public:
         // cylinder1 = new Cylinder({1, 0, 0}, {0, cylinderDist / 2, 0}, cylRad + 0.02);
         // cylinder2 = new Cylinder({1, 0, 0}, {0, -cylinderDist / 2, 0}, cylRad + 0.02);
 
+        Colliders &colliders = solver->getColliders();
+
         if (ImGui::SliderFloat("Cylinder Angle", &cylinderTheta, 0, 360)) {
             float theta = glm::radians(cylinderTheta);
-            cylinder1->dir = {cos(theta), 0, -sin(theta)};
-            cylinder2->dir = {cos(theta), 0, sin(theta)};
+            colliders.getCylinder(0).dir = {cos(theta), 0, -sin(theta)};
+            colliders.getCylinder(1).dir = {cos(theta), 0, sin(theta)};
         }
 
         if (ImGui::SliderFloat("Cylinder distance", &cylinderDist, 0, 10)) {
-            cylinder1->p.y = cylinderDist / 2;
-            cylinder2->p.y = -cylinderDist / 2;
+            colliders.getCylinder(0).p.y = cylinderDist / 2;
+            colliders.getCylinder(1).p.y = -cylinderDist / 2;
+        }
+
+        if (ImGui::Checkbox("Use triangle self collision", &selfCollision)) {
+            solver->setSelfCollision(selfCollision);
         }
 
         ImGui::Checkbox("Draw lines", &drawLines);
@@ -165,8 +168,5 @@ private:
     std::shared_ptr<Mesh> cylinderMesh1;
     std::shared_ptr<Mesh> cylinderMesh2;
 
-    Cylinder *cylinder1;
-    Cylinder *cylinder2;
-
     float cylRad = 0.1f;
 };
\ No newline at end of file
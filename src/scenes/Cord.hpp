@@ -12,6 +12,7 @@ public:
     float alphaDistance = 1e-8;
 
     Cord(int nParticles = 3, float distance = 0.5f) : nParticles(nParticles), distance(distance) {
+        Arena::Scope scope(arena);
 
         std::vector<glm::vec3> pos;
         std::vector<Constraint *> constraints;
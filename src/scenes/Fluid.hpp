@@ -1,102 +1,144 @@
-// This scene does not work
-
 #pragma once
 #include "Scene.hpp"
 #include "utils/utils.hpp"
 #include "imgui.h"
+#include "utils/SDF.hpp"
+#include "mesh/FluidSurface.hpp"
+#include "render/ParticleRenderer.hpp"
 
 class Fluid : public Scene {
 public:
     // Parameters
     int size_x, size_y, size_z;
-    float alphaDensity = 1e-3;
+    bool bunny;
+    bool showSurface = true;
+    int renderMode = (int)ParticleRenderer::Mode::IMPOSTOR;
+    float alphaDensity = 1e-8;
     float alphaPlaneCollision = 1e-8;
+    float viscosity = 0.1f;
 
-    Fluid(int size_x = 10, int size_y = 10, int size_z = 10) : size_x(size_x), size_y(size_y), size_z(size_z) {
+    Fluid(int size_x = 10, int size_y = 10, int size_z = 10, bool bunny = false)
+        : size_x(size_x), size_y(size_y), size_z(size_z), bunny(bunny) {
+        Arena::Scope scope(arena);
         std::vector<glm::vec3> pos;
         std::vector<Constraint *> constraints;
 
-        float pRadius = 0.01;
-        DensityConstraint::d0 = 1000;
-        DensityConstraint::h = 4.0f * pRadius;
-        DensityConstraint::m = DensityConstraint::d0 * pow(DensityConstraint::h, 3);
+        const float pRadius = 0.05f;
+        const float restDensity = 1000;
+        const float spacing = 2.0f * pRadius;
 
-        sphere = Mesh::createSphere(pRadius);
+        particles = std::make_shared<ParticleRenderer>(pRadius, (ParticleRenderer::Mode)renderMode);
         box = Mesh::createBox();
 
-        const std::vector<glm::vec3> &vertexBox = box->getVertices();
+        // The surface lies about pRadius outside of the outer particles
+        surface = std::make_shared<FluidSurface>(0.5f * pRadius, 3.0f * pRadius, 0.8f, 0.05f * pRadius);
+        surfaceMesh = std::make_shared<Mesh>(std::vector<glm::vec3>(), std::vector<glm::vec3>(), std::vector<uint>());
 
-        planes = {
-            new SemiPlane(vertexBox[0], vertexBox[1], vertexBox[2]),
-            new SemiPlane(vertexBox[4], vertexBox[6], vertexBox[5]),
-            new SemiPlane(vertexBox[8], vertexBox[9], vertexBox[10]),
-            new SemiPlane(vertexBox[12], vertexBox[14], vertexBox[13]),
-            new SemiPlane(vertexBox[16], vertexBox[18], vertexBox[17]),
-            new SemiPlane(vertexBox[20], vertexBox[21], vertexBox[22]),
-        };
+        const std::vector<glm::vec3> &vertexBox = box->getVertices();
 
-        const float spacing = 2.0f * pRadius;
-        uint counter = 0;
         for (int i = 0; i < size_x; i++) {
             for (int j = 0; j < size_y; j++) {
                 for (int k = 0; k < size_z; k++) {
 
                     float offset_x = (size_x - 1) * spacing * 0.5f;
-                    float offset_y = (size_y - 1) * spacing * 0.5f;
+                    float offset_y = (size_y - 1) * spacing * 0.5f - 0.5f;
                     float offset_z = (size_z - 1) * spacing * 0.5f;
 
                     pos.emplace_back(i * spacing - offset_x, j * spacing - offset_y, k * spacing - offset_z);
-
-                    constraints.push_back(new DensityConstraint(counter, &alphaDensity));
-                    counter++;
                 }
             }
         }
 
-        for (int i = 0; i < pos.size(); i++) {
-            for (SemiPlane *plane : planes) {
-                constraints.push_back(new SemiPlaneConstraint(i, plane, &alphaPlaneCollision, pRadius));
-            }
+        // Each particle stands for a cube of fluid of side spacing
+        solver = new Solver(pos, constraints, restDensity * spacing * spacing * spacing);
+        solver->activateFluids(2.0f * spacing, restDensity, &alphaDensity);
+
+        // The walls and the obstacle are seen by the fluid as boundary particles.
+        // Sampling them finer than the fluid keeps the particles from slipping between the samples.
+        FluidSolver &fluids = solver->getFluids();
+        fluids.addBoundary(box->getVertices(), box->getIndices(), pRadius);
+
+        // The colliders stop the particles that would still go through
+        Colliders &colliders = solver->getColliders();
+
+        if (bunny) {
+            obstacle = Mesh::createFromOFF("data/mesh/bunny.off");
+            obstacle->applyTransform(utils::getTranslate(0.0f, -0.574f, 0.0f) * utils::getScale(7));
+            fluids.addBoundary(obstacle->getVertices(), obstacle->getIndices(), pRadius);
+
+            colliders.addSDF(SDF::createFromMesh(obstacle->getVertices(), obstacle->getIndices(), 0.04f, 3, "data/cache/bunny_fluid.sdf"), pRadius);
         }
 
-        solver = new Solver(pos, constraints, DensityConstraint::m);
-        solver->activateFluids();
+        colliders.addPlane(SemiPlane(vertexBox[0], vertexBox[1], vertexBox[2]), pRadius);
+        colliders.addPlane(SemiPlane(vertexBox[4], vertexBox[6], vertexBox[5]), pRadius);
+        colliders.addPlane(SemiPlane(vertexBox[8], vertexBox[9], vertexBox[10]), pRadius);
+        colliders.addPlane(SemiPlane(vertexBox[12], vertexBox[14], vertexBox[13]), pRadius);
+        colliders.addPlane(SemiPlane(vertexBox[16], vertexBox[18], vertexBox[17]), pRadius);
+        colliders.addPlane(SemiPlane(vertexBox[20], vertexBox[21], vertexBox[22]), pRadius);
+        colliders.setCompliance(&alphaPlaneCollision);
     }
 
-    Fluid(const Fluid &scene) : Fluid(size_x, size_y, size_z) {
+    Fluid(const Fluid &scene) : Fluid(scene.size_x, scene.size_y, scene.size_z, scene.bunny) {
         this->alphaDensity = scene.alphaDensity;
         this->alphaPlaneCollision = scene.alphaPlaneCollision;
+        this->viscosity = scene.viscosity;
+        this->showSurface = scene.showSurface;
+        this->renderMode = scene.renderMode;
+        particles->mode = (ParticleRenderer::Mode)renderMode;
+        solver->getFluids().viscosity = viscosity;
     }
 
     ~Fluid() override {
     }
 
     void draw(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap) override {
-        shaderProgram.use();
-        sphere->startDrawMultiple(shaderProgram);
-
-        for (const glm::vec3 &pos : solver->getPos()) {
-            sphere->addDrawMultiple(shaderProgram, glm::vec3(0.7), utils::getTranslate(pos));
+        if (showSurface) {
+            if (positionsChanged()) {
+                surface->update(solver->getPos());
+                surfaceMesh->setGeometry(surface->getVertices(), surface->getNormals(), surface->getIndices());
+            }
+            surfaceMesh->draw(shaderProgram, glm::vec3(0.2, 0.4, 0.8), glm::mat4(1.0));
+        } else {
+            particles->draw(shaderProgram, solver->getPos(), glm::vec3(0.2, 0.4, 0.8));
         }
 
-        sphere->endDrawMultiple();
-
         box->draw(shaderProgram, glm::vec3(0.7), glm::mat4(1.0));
+
+        if (obstacle) {
+            obstacle->draw(shaderProgram, glm::vec3(1.0, 0.9, 0.2), glm::mat4(1.0));
+        }
     }
 
     bool showUI() override {
         bool changed = false;
 
+        if (ImGui::SliderFloat("Viscosity", &viscosity, 0.0f, 1.0f)) {
+            solver->getFluids().viscosity = viscosity;
+        }
+
+        if (ImGui::Checkbox("Bunny obstacle", &bunny)) {
+            changed = true;
+        }
+
+        ImGui::Checkbox("Surface", &showSurface);
+        if (showSurface) {
+            ImGui::Text("Blocks: %u, remeshed: %u", surface->getBlockCount(), surface->getRemeshedCount());
+        } else if (ImGui::Combo("Particles", &renderMode, "Mesh\0Impostor\0")) {
+            particles->mode = (ParticleRenderer::Mode)renderMode;
+        }
+
         return changed;
     }
 
     void showConstraintUI() override {
-        alphaSelector("Distance", alphaDensity);
+        alphaSelector("Density", alphaDensity);
+        alphaSelector("Collision", alphaPlaneCollision);
     }
 
 private:
-    std::shared_ptr<Mesh> sphere;
+    std::shared_ptr<ParticleRenderer> particles;
     std::shared_ptr<Mesh> box;
-
-    std::vector<SemiPlane *> planes;
+    std::shared_ptr<Mesh> obstacle;
+    std::shared_ptr<FluidSurface> surface;
+    std::shared_ptr<Mesh> surfaceMesh;
 };
\ No newline at end of file
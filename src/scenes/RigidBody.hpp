@@ -16,15 +16,13 @@ public:
     float alphaCollision = 1e-8;
 
     RigidBody() {
+        Arena::Scope scope(arena);
 
         std::vector<Constraint *> constraints;
 
         plane = Mesh::createPlane();
         plane->applyTransform(utils::getTranslateY(-1.5) * utils::getScale(500));
 
-        const std::vector<glm::vec3> &v = plane->getVertices();
-        semiPlane = new SemiPlane(v[0], v[1], v[2]);
-
         int res = 10;
         // body = RigidMesh::createCube(res);
         body = RigidMesh::createFromOFF("data/mesh/bunny-low-poly.off");
@@ -34,12 +32,13 @@ public:
 
         const std::vector<glm::vec3> &pos = body->getPos();
 
-        for (int i = 0; i < pos.size(); i++) {
-            constraints.push_back(new SemiPlaneConstraint(i, semiPlane, &alphaCollision));
-        }
-
         solver = new Solver(pos, constraints);
+
+        const std::vector<glm::vec3> &v = plane->getVertices();
+        solver->getColliders().addPlane(SemiPlane(v[0], v[1], v[2]));
+        solver->getColliders().setCompliance(&alphaCollision);
         solver->activateRigid(body.get());
+        body->setVertexSource(solver->getPos(), &body->getMeshToPos());
     }
 
     RigidBody(const RigidBody &scene) : RigidBody() {
@@ -48,20 +47,22 @@ public:
         this->alphaDistance = scene.alphaDistance;
     }
 
-    ~RigidBody() override {
-        delete semiPlane;
-    }
-
     void draw(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap) override {
-        shadowMap.beginRender();
-        shadowMap.addObject(body);
-        shadowMap.endRender();
+        if (positionsChanged()) {
+            body->updateNormals();
+        }
+
+        if (shadowMap.needsRender(solver->getVersion())) {
+            shadowMap.beginRender();
+            shadowMap.addObject(body);
+            shadowMap.endRender();
+        }
 
         shaderProgram.use();
         if (!showSpheres)
             body->draw(shaderProgram, glm::vec3(0.7, 0, 0), glm::mat4(1.0));
         else
-            for (const glm::vec3 &pos : body->getPos()) {
+            for (const glm::vec3 &pos : solver->getPos()) {
                 sphere->draw(shaderProgram, glm::vec3(0.7, 0, 0), utils::getTranslate(pos));
             }
 
@@ -87,8 +88,6 @@ public:
 private:
     std::shared_ptr<Mesh> plane;
 
-    SemiPlane *semiPlane;
-
     std::shared_ptr<RigidMesh> body;
     std::shared_ptr<Mesh> sphere;
 
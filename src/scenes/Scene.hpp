@@ -11,6 +11,7 @@
 #include "simulation/Solver.hpp"
 #include "mesh/Mesh.hpp"
 #include "render/ShadowMap.hpp"
+#include "utils/Arena.hpp"
 #include "imgui.h"
 
 class Scene {
@@ -25,6 +26,40 @@ public:
     virtual void showConstraintUI() {}
 
     const std::vector<glm::vec3> &getPos() { return solver->getPos(); }
+
+protected:
+    // Constraints of the scene: constructors build them in an Arena::Scope(arena). Released after the solver.
+    Arena arena;
+
+    // True at the first call after the positions changed: meshes following the solver only need an update then
+    bool positionsChanged() {
+        if (drawnVersion == solver->getVersion()) return false;
+        drawnVersion = solver->getVersion();
+        return true;
+    }
+
+    // Two-sided cloth: both meshes read the positions of the solver, the back one with flipped normals
+    void followSolver(Mesh &front, Mesh &back) {
+        front.setVertexSource(solver->getPos());
+        back.setVertexSource(solver->getPos());
+    }
+
+    void updateCloth(const std::shared_ptr<Mesh> &front, const std::shared_ptr<Mesh> &back, ShadowMap &shadowMap) {
+        if (positionsChanged()) {
+            front->updateNormals();
+            back->setFlippedNormals(*front);
+        }
+
+        if (shadowMap.needsRender(solver->getVersion())) {
+            shadowMap.beginRender();
+            shadowMap.addObject(front);
+            shadowMap.addObject(back);
+            shadowMap.endRender();
+        }
+    }
+
+private:
+    uint64_t drawnVersion = 0;
 };
 
 inline void alphaSelector(const char *label, float &alpha) {
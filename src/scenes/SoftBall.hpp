@@ -2,7 +2,7 @@
 #include "Scene.hpp"
 #include "utils/utils.hpp"
 #include "imgui.h"
-#include <set>
+#include "mesh/MeshLoader.hpp"
 
 class SoftBall : public Scene {
 public:
@@ -14,52 +14,36 @@ public:
     float alphaCollision = 1e-8;
 
     SoftBall(float pressure = 1.0f, int meshIdx = 0) : pressure(pressure), meshIdx(meshIdx) {
+        Arena::Scope scope(arena);
         std::vector<Constraint *> constraints;
 
         plane = Mesh::createPlane();
         plane->applyTransform(utils::getTranslateY(-1.5) * utils::getScale(500));
 
-        const std::vector<glm::vec3> &v = plane->getVertices();
-        semiPlane = new SemiPlane(v[0], v[1], v[2]);
-
-        if (meshIdx == 0) {
-            ball = Mesh::createFromOFF("data/mesh/sphere_detailled.off");
-        } else if (meshIdx == 1) {
-            ball = Mesh::createFromOFF("data/mesh/sphere_one_sub.off");
-        } else if (meshIdx == 2) {
-            ball = Mesh::createFromOFF("data/mesh/bunny.off");
-            ball->applyTransform(utils::getScale(10));
-        }
+        const char *paths[] = {"data/mesh/sphere_detailled.off", "data/mesh/sphere_one_sub.off", "data/mesh/bunny.off"};
+        const MeshData data = MeshLoader::loadOFF(paths[meshIdx], MeshLoader::defaultCachePath(paths[meshIdx]));
+
+        ball = std::make_shared<Mesh>(data.vertices, std::vector<glm::vec3>(data.vertices.size()), data.indices);
+        if (meshIdx == 2) ball->applyTransform(utils::getScale(10));
+        ball->updateNormals();
 
         const std::vector<glm::vec3> &pos = ball->getVertices();
         const std::vector<uint> &indices = ball->getIndices();
 
         constraints.push_back(new MeshVolumeConstraint(indices, pos, &this->pressure, &alphaVolume));
 
-        // Compute unique edges
-        std::set<std::pair<uint, uint>> edgeSet;
-
-        for (int i = 0; i < indices.size(); i += 3) {
-            uint a = indices[i];
-            uint b = indices[i + 1];
-            uint c = indices[i + 2];
-
-            edgeSet.insert({std::min(a, b), std::max(a, b)});
-            edgeSet.insert({std::min(a, c), std::max(a, c)});
-            edgeSet.insert({std::min(b, c), std::max(b, c)});
-        }
-
-        for (const auto &edge : edgeSet) {
-            const glm::vec3 &p1 = pos[edge.first];
-            const glm::vec3 &p2 = pos[edge.second];
-            constraints.push_back(new DistanceConstraint(edge.first, edge.second, glm::length(p1 - p2), &alphaDistance));
-        }
-
-        for (int i = 0; i < pos.size(); i++) {
-            constraints.push_back(new SemiPlaneConstraint(i, semiPlane, &alphaCollision));
+        // Unique edges, given by the loader
+        for (int i = 0; i < data.edges.size(); i += 2) {
+            const uint a = data.edges[i], b = data.edges[i + 1];
+            constraints.push_back(new DistanceConstraint(a, b, glm::length(pos[a] - pos[b]), &alphaDistance));
         }
 
         solver = new Solver(pos, constraints);
+        ball->setVertexSource(solver->getPos());
+
+        const std::vector<glm::vec3> &v = plane->getVertices();
+        solver->getColliders().addPlane(SemiPlane(v[0], v[1], v[2]));
+        solver->getColliders().setCompliance(&alphaCollision);
     }
 
     SoftBall(const SoftBall &scene) : SoftBall(scene.pressure, scene.meshIdx) {
@@ -68,18 +52,18 @@ public:
         this->alphaDistance = scene.alphaDistance;
     }
 
-    ~SoftBall() override {
-        delete semiPlane;
-    }
-
     void draw(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap) override {
-        shadowMap.beginRender();
-        shadowMap.addObject(ball);
-        shadowMap.endRender();
+        if (positionsChanged()) {
+            ball->updateNormals();
+        }
+
+        if (shadowMap.needsRender(solver->getVersion())) {
+            shadowMap.beginRender();
+            shadowMap.addObject(ball);
+            shadowMap.endRender();
+        }
 
         shaderProgram.use();
-        ball->setVertices(solver->getPos());
-        ball->updateNormals();
         ball->draw(shaderProgram, glm::vec3(0, 0, 0.7), glm::mat4(1.0));
 
         checkerShaderProgram.use();
@@ -109,7 +93,5 @@ private:
     std::shared_ptr<Mesh> plane;
     std::shared_ptr<Mesh> ball;
 
-    SemiPlane *semiPlane;
-
     static constexpr std::array<const char *, 3> names = {"sphere_detailled", "sphere_one_sub", "bunny"};
 };
\ No newline at end of file
@@ -13,56 +13,82 @@ public:
     float alphaVolume = 1e-8;
     float alphaCollision = 1e-8;
 
-    SoftBody() {
+    bool terrain;
 
-        std::vector<Constraint *> constraints;
+    SoftBody(bool terrain = false) : terrain(terrain) {
+        Arena::Scope scope(arena);
 
-        plane = Mesh::createPlane();
-        plane->applyTransform(utils::getTranslateY(-1.5) * utils::getScale(500));
-
-        const std::vector<glm::vec3> &v = plane->getVertices();
-        semiPlane = new SemiPlane(v[0], v[1], v[2]);
+        if (terrain) {
+            heightfield = Heightfield::createFromPGM("data/terrain/hills.pgm", 0.1f, -1.95f, -1.05f);
+            plane = Mesh::createHeightfield(*heightfield);
+        } else {
+            plane = Mesh::createPlane();
+            plane->applyTransform(utils::getTranslateY(-1.5) * utils::getScale(500));
+        }
 
         float size = 1;
         // body = TetraMesh::createCube(size);
-        body = TetraMesh::createBunny();
+        body = TetraMesh::createFromTetGen("data/mesh/bunny");
 
         const std::vector<glm::vec3> &pos = body->getPos();
         const std::vector<uint> &edges = body->getEdges();
         const std::vector<uint> &tets = body->getTets();
 
-        for (int i = 0; i < edges.size(); i += 2) {
-            constraints.push_back(new DistanceConstraint(edges[i], edges[i + 1], glm::length(pos[edges[i]] - pos[edges[i + 1]]), &alphaDistance));
+        // Edges then tetrahedra, each constraint at its place: built in parallel for large meshes.
+        // The current arena is per thread: each thread opens its scope.
+        const int nEdges = edges.size() / 2;
+        const int nTets = tets.size() / 4;
+        std::vector<Constraint *> constraints(nEdges + nTets);
+        arena.reserve(nEdges * Arena::objectSize<DistanceConstraint>(2 * sizeof(uint)) +
+                      nTets * Arena::objectSize<VolumeConstraint>(4 * sizeof(uint) + 4 * sizeof(glm::vec3)));
+
+#pragma omp parallel
+        {
+            Arena::Scope threadScope(arena);
+
+#pragma omp for schedule(static)
+            for (int i = 0; i < nEdges; i++) {
+                const uint a = edges[2 * i], b = edges[2 * i + 1];
+                constraints[i] = new DistanceConstraint(a, b, glm::length(pos[a] - pos[b]), &alphaDistance);
+            }
+
+#pragma omp for schedule(static)
+            for (int i = 0; i < nTets; i++) {
+                const uint *t = &tets[4 * i];
+                constraints[nEdges + i] = new VolumeConstraint(t[0], t[1], t[2], t[3], pos, &alphaVolume);
+            }
         }
 
-        for (int i = 0; i < tets.size(); i += 4) {
-            constraints.push_back(new VolumeConstraint(tets[i], tets[i + 1], tets[i + 2], tets[i + 3], pos, &alphaVolume));
-        }
+        solver = new Solver(pos, constraints);
+        body->setVertexSource(solver->getPos(), &body->getMeshToPos());
 
-        for (int i = 0; i < pos.size(); i++) {
-            constraints.push_back(new SemiPlaneConstraint(i, semiPlane, &alphaCollision, 0));
+        if (terrain) {
+            solver->getColliders().addHeightfield(heightfield);
+        } else {
+            const std::vector<glm::vec3> &v = plane->getVertices();
+            solver->getColliders().addPlane(SemiPlane(v[0], v[1], v[2]), 0);
         }
-
-        solver = new Solver(pos, constraints);
+        solver->getColliders().setCompliance(&alphaCollision);
     }
 
-    SoftBody(const SoftBody &scene) : SoftBody() {
+    SoftBody(const SoftBody &scene) : SoftBody(scene.terrain) {
         this->alphaCollision = scene.alphaCollision;
         this->alphaVolume = scene.alphaVolume;
         this->alphaDistance = scene.alphaDistance;
     }
 
-    ~SoftBody() override {
-        delete semiPlane;
-    }
-
     void draw(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap) override {
-        shadowMap.beginRender();
-        shadowMap.addObject(body);
-        shadowMap.endRender();
+        if (positionsChanged()) {
+            body->updateNormals();
+        }
+
+        if (shadowMap.needsRender(solver->getVersion())) {
+            shadowMap.beginRender();
+            shadowMap.addObject(body);
+            shadowMap.endRender();
+        }
 
         shaderProgram.use();
-        body->udpatePos(solver->getPos());
         body->draw(shaderProgram, glm::vec3(0.7, 0, 0), glm::mat4(1.0));
 
         checkerShaderProgram.use();
@@ -73,6 +99,10 @@ public:
     bool showUI() override {
         bool changed = false;
 
+        if (ImGui::Checkbox("Uneven terrain", &terrain)) {
+            changed = true;
+        }
+
         return changed;
     }
 
@@ -84,8 +114,7 @@ public:
 
 private:
     std::shared_ptr<Mesh> plane;
-
-    SemiPlane *semiPlane;
+    std::shared_ptr<Heightfield> heightfield;
 
     std::shared_ptr<TetraMesh> body;
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Scene.hpp"
 #include "utils/utils.hpp"
 #include "imgui.h"
+#include "render/ParticleRenderer.hpp"
 
 #include <ctime>
 
@@ -12,26 +13,19 @@ public:
 
     float alphaPlaneCollision = 1e-8;
     float alphaCollision = 1e-8;
+    int renderMode = (int)ParticleRenderer::Mode::IMPOSTOR;
 
     Spheres(int totalParticles = 300, float pRadius = 0.1) : spawnParticles(totalParticles), pRadius(pRadius) {
+        Arena::Scope scope(arena);
 
         std::vector<glm::vec3> pos;
         std::vector<Constraint *> constraints;
 
-        sphere = Mesh::createSphere(pRadius);
+        particles = std::make_shared<ParticleRenderer>(pRadius, (ParticleRenderer::Mode)renderMode);
         box = Mesh::createBox();
 
         const std::vector<glm::vec3> &vertexBox = box->getVertices();
 
-        planes = {
-            new SemiPlane(vertexBox[0], vertexBox[1], vertexBox[2]),
-            new SemiPlane(vertexBox[4], vertexBox[6], vertexBox[5]),
-            new SemiPlane(vertexBox[8], vertexBox[9], vertexBox[10]),
-            new SemiPlane(vertexBox[12], vertexBox[14], vertexBox[13]),
-            new SemiPlane(vertexBox[16], vertexBox[18], vertexBox[17]),
-            // new SemiPlane(vertexBox[20], vertexBox[21], vertexBox[22]),
-        };
-
         std::srand(static_cast<unsigned>(std::time(nullptr)));
 
         const float bound = 1.0f - pRadius;
@@ -42,39 +36,32 @@ public:
             float z = -bound + static_cast<float>(std::rand()) / (static_cast<float>(RAND_MAX / 2.0f)) * bound;
             pos.push_back(glm::vec3(x, y, z));
 
-            for (SemiPlane *plane : planes) {
-                constraints.push_back(new SemiPlaneConstraint(i, plane, &alphaPlaneCollision, pRadius));
-            }
-
             for (int j = 0; j < i; j++) {
                 constraints.push_back(new MinDistanceConstraint(i, j, 2 * pRadius, &alphaCollision));
             }
         }
 
         solver = new Solver(pos, constraints);
+
+        Colliders &colliders = solver->getColliders();
+        colliders.addPlane(SemiPlane(vertexBox[0], vertexBox[1], vertexBox[2]), pRadius);
+        colliders.addPlane(SemiPlane(vertexBox[4], vertexBox[6], vertexBox[5]), pRadius);
+        colliders.addPlane(SemiPlane(vertexBox[8], vertexBox[9], vertexBox[10]), pRadius);
+        colliders.addPlane(SemiPlane(vertexBox[12], vertexBox[14], vertexBox[13]), pRadius);
+        colliders.addPlane(SemiPlane(vertexBox[16], vertexBox[18], vertexBox[17]), pRadius);
+        // colliders.addPlane(SemiPlane(vertexBox[20], vertexBox[21], vertexBox[22]), pRadius);
+        colliders.setCompliance(&alphaPlaneCollision);
     }
 
     Spheres(const Spheres &scene) : Spheres(scene.spawnParticles, scene.pRadius) {
         this->alphaCollision = scene.alphaCollision;
         this->alphaPlaneCollision = scene.alphaPlaneCollision;
-    }
-
-    ~Spheres() override {
-        for (SemiPlane *plane : planes) {
-            delete plane;
-        }
-        planes.clear();
+        this->renderMode = scene.renderMode;
+        particles->mode = (ParticleRenderer::Mode)renderMode;
     }
 
     void draw(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap) override {
-        shaderProgram.use();
-        sphere->startDrawMultiple(shaderProgram);
-
-        for (const glm::vec3 &pos : solver->getPos()) {
-            sphere->addDrawMultiple(shaderProgram, glm::vec3(0.7), utils::getTranslate(pos));
-        }
-
-        sphere->endDrawMultiple();
+        particles->draw(shaderProgram, solver->getPos(), glm::vec3(0.7));
 
         box->draw(shaderProgram, glm::vec3(0.7), glm::mat4(1.0));
     }
@@ -101,6 +88,10 @@ public:
             }
         }
 
+        if (ImGui::Combo("Particles", &renderMode, "Mesh\0Impostor\0")) {
+            particles->mode = (ParticleRenderer::Mode)renderMode;
+        }
+
         return changed;
     }
 
@@ -110,8 +101,7 @@ public:
     }
 
 private:
-    std::shared_ptr<Mesh> sphere;
+    std::shared_ptr<ParticleRenderer> particles;
     std::shared_ptr<Mesh> box;
 
-    std::vector<SemiPlane *> planes;
 };
\ No newline at end of file
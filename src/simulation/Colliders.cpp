@@ -0,0 +1,257 @@
+#include "Colliders.hpp"
+#include <utility>
+
+uint Colliders::addPlane(const SemiPlane &plane, float dist) {
+    planes.push_back({plane, dist});
+    return planes.size() - 1;
+}
+
+uint Colliders::addBox(const glm::vec3 &center, const glm::vec3 &halfSize, float dist) {
+    boxes.push_back({center, halfSize, dist});
+    return boxes.size() - 1;
+}
+
+uint Colliders::addSphere(const glm::vec3 &center, float radius) {
+    spheres.push_back({center, radius});
+    return spheres.size() - 1;
+}
+
+uint Colliders::addCylinder(const Cylinder &cylinder) {
+    cylinders.push_back(cylinder);
+    return cylinders.size() - 1;
+}
+
+uint Colliders::addSDF(std::shared_ptr<const SDF> sdf, float dist) {
+    sdfs.push_back({sdf, dist});
+    return sdfs.size() - 1;
+}
+
+uint Colliders::addHeightfield(std::shared_ptr<const Heightfield> heightfield, float dist) {
+    heightfields.push_back({heightfield, dist});
+    return heightfields.size() - 1;
+}
+
+float Colliders::distance(uint collider, const glm::vec3 &p, glm::vec3 &grad) const {
+    const uint i = collider & 0x0FFFFFFF;
+
+    switch (collider >> 28) {
+    case PLANE: {
+        const PlaneCollider &plane = planes[i];
+        grad = plane.plane.n;
+        return glm::dot(p - plane.plane.p, plane.plane.n) - plane.dist;
+    }
+    case BOX: {
+        const BoxCollider &box = boxes[i];
+        const glm::vec3 d = p - box.center;
+        const glm::vec3 q = glm::abs(d) - box.halfSize;
+        const glm::vec3 s = glm::sign(d);
+
+        if (q.x > 0 || q.y > 0 || q.z > 0) {
+            const glm::vec3 outside = glm::max(q, 0.0f);
+            const float len = glm::length(outside);
+            grad = s * outside / len;
+            return len - box.dist;
+        }
+
+        // Inside: push out through the closest face
+        int axis = 0;
+        if (q.y > q[axis]) axis = 1;
+        if (q.z > q[axis]) axis = 2;
+        grad = glm::vec3(0);
+        grad[axis] = s[axis] != 0 ? s[axis] : 1.0f;
+        return q[axis] - box.dist;
+    }
+    case SPHERE: {
+        const SphereCollider &sphere = spheres[i];
+        const glm::vec3 d = p - sphere.center;
+        const float len = glm::length(d);
+        grad = len > 1e-6f ? d / len : glm::vec3(0, 1, 0);
+        return len - sphere.radius;
+    }
+    case CYLINDER: {
+        const Cylinder &cylinder = cylinders[i];
+        const glm::vec3 d = p - cylinder.p;
+        const glm::vec3 radial = d - glm::dot(d, cylinder.dir) * cylinder.dir;
+        const float len = glm::length(radial);
+        grad = len > 1e-6f ? radial / len : glm::vec3(0, 1, 0);
+        return len - cylinder.r;
+    }
+    case DISTANCE_FIELD: {
+        const SDFCollider &field = sdfs[i];
+        return field.sdf->sample(p, grad) - field.dist;
+    }
+    default: {
+        // Height above the terrain projected on the normal, close to the distance on smooth terrains
+        const HeightfieldCollider &terrain = heightfields[i];
+        const float h = terrain.heightfield->height(p.x, p.z, grad);
+        return (p.y - h) * grad.y - terrain.dist;
+    }
+    }
+}
+
+void Colliders::findContacts(const std::vector<glm::vec3> &pos, float margin) {
+    const uint n = pos.size();
+
+    std::vector<uint> colliders;
+    for (uint i = 0; i < planes.size(); i++) colliders.push_back(PLANE << 28 | i);
+    for (uint i = 0; i < boxes.size(); i++) colliders.push_back(BOX << 28 | i);
+    for (uint i = 0; i < spheres.size(); i++) colliders.push_back(SPHERE << 28 | i);
+    for (uint i = 0; i < cylinders.size(); i++) colliders.push_back(CYLINDER << 28 | i);
+    for (uint i = 0; i < sdfs.size(); i++) colliders.push_back(DISTANCE_FIELD << 28 | i);
+    for (uint i = 0; i < heightfields.size(); i++) colliders.push_back(HEIGHTFIELD << 28 | i);
+
+    // Count, then fill, so the result does not depend on the scheduling
+    std::vector<uint> count(n + 1, 0);
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < (int)n; i++) {
+        glm::vec3 grad;
+        for (uint collider : colliders) {
+            if (distance(collider, pos[i], grad) < margin) count[i + 1]++;
+        }
+    }
+
+    for (uint i = 0; i < n; i++) count[i + 1] += count[i];
+
+    std::vector<uint> all(count[n]);
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < (int)n; i++) {
+        glm::vec3 grad;
+        uint k = count[i];
+        for (uint collider : colliders) {
+            if (distance(collider, pos[i], grad) < margin) all[k++] = collider;
+        }
+    }
+
+    // Keep only the particles having contacts
+    contactParticles.clear();
+    contactOffsets.assign(1, 0);
+    contacts.clear();
+    for (uint i = 0; i < n; i++) {
+        if (count[i + 1] == count[i]) continue;
+        contacts.insert(contacts.end(), all.begin() + count[i], all.begin() + count[i + 1]);
+        contactParticles.push_back(i);
+        contactOffsets.push_back(contacts.size());
+    }
+}
+
+void Colliders::solve(std::vector<glm::vec3> &pos, const std::vector<float> &w, float dt) const {
+    const float alphaTilde = alpha ? *alpha / (dt * dt) : 0.0f;
+
+#pragma omp parallel for schedule(static)
+    for (int k = 0; k < (int)contactParticles.size(); k++) {
+        const uint i = contactParticles[k];
+        if (w[i] == 0) continue;
+
+        // One particle at a time: its colliders are solved in sequence
+        for (uint c = contactOffsets[k]; c < contactOffsets[k + 1]; c++) {
+            glm::vec3 grad;
+            const float C = distance(contacts[c], pos[i], grad);
+            if (C >= 0) continue;
+
+            const float dlambda = -C / (w[i] + alphaTilde);
+            pos[i] += w[i] * dlambda * grad;
+        }
+    }
+}
+
+float Colliders::timeOfImpact(const glm::vec3 &from, const glm::vec3 &to, glm::vec3 &normal) const {
+    float toi = 1.0f;
+    uint first = 0; // collider hit first
+    const glm::vec3 d = to - from;
+    auto hit = [&](float t, uint collider) {
+        if (t < toi) {
+            toi = t;
+            first = collider;
+        }
+    };
+
+    for (uint i = 0; i < planes.size(); i++) {
+        const PlaneCollider &plane = planes[i];
+        const float d0 = glm::dot(from - plane.plane.p, plane.plane.n) - plane.dist;
+        const float d1 = glm::dot(to - plane.plane.p, plane.plane.n) - plane.dist;
+        if (d0 >= 0 && d1 < 0) hit(d0 / (d0 - d1), PLANE << 28 | i);
+    }
+
+    for (uint i = 0; i < spheres.size(); i++) {
+        hit(utils::sweptSphereTimeOfImpact(from - spheres[i].center, d, spheres[i].radius), SPHERE << 28 | i);
+    }
+
+    for (uint i = 0; i < cylinders.size(); i++) {
+        const Cylinder &cylinder = cylinders[i];
+        const glm::vec3 p = from - cylinder.p;
+        hit(utils::sweptSphereTimeOfImpact(p - glm::dot(p, cylinder.dir) * cylinder.dir,
+                                           d - glm::dot(d, cylinder.dir) * cylinder.dir, cylinder.r),
+            CYLINDER << 28 | i);
+    }
+
+    // Slab test against the boxes, inflated by their distance
+    for (uint i = 0; i < boxes.size(); i++) {
+        const BoxCollider &box = boxes[i];
+        const glm::vec3 lo = box.center - box.halfSize - glm::vec3(box.dist);
+        const glm::vec3 hi = box.center + box.halfSize + glm::vec3(box.dist);
+        if (glm::all(glm::greaterThan(from, lo)) && glm::all(glm::lessThan(from, hi))) continue; // already inside
+
+        float tEnter = 0.0f, tExit = 1.0f;
+        for (int a = 0; a < 3 && tEnter <= tExit; a++) {
+            if (glm::abs(d[a]) < 1e-12f) {
+                if (from[a] < lo[a] || from[a] > hi[a]) tEnter = 2.0f;
+                continue;
+            }
+            float t0 = (lo[a] - from[a]) / d[a];
+            float t1 = (hi[a] - from[a]) / d[a];
+            if (t0 > t1) std::swap(t0, t1);
+            tEnter = glm::max(tEnter, t0);
+            tExit = glm::min(tExit, t1);
+        }
+        if (tEnter <= tExit && tEnter < 1.0f) hit(tEnter, BOX << 28 | i);
+    }
+
+    // Sphere tracing along the motion: the distance is a safe step
+    const float len = glm::length(d);
+    for (uint i = 0; i < sdfs.size(); i++) {
+        const SDFCollider &field = sdfs[i];
+        if (len < 1e-9f) break;
+
+        glm::vec3 grad;
+        float t = 0.0f;
+        if (field.sdf->sample(from, grad) - field.dist < 0) continue; // already inside
+
+        for (int step = 0; step < 32 && t < toi; step++) {
+            const float dist = field.sdf->sample(from + t * d, grad) - field.dist;
+            if (dist <= 0) {
+                hit(t, DISTANCE_FIELD << 28 | i);
+                break;
+            }
+            t += glm::max(dist, 0.1f * field.sdf->getCellSize()) / len;
+        }
+    }
+
+    // Heightfields: first sign change along the motion, sampled about once per cell
+    for (uint i = 0; i < heightfields.size(); i++) {
+        const HeightfieldCollider &terrain = heightfields[i];
+        const uint collider = HEIGHTFIELD << 28 | i;
+
+        glm::vec3 grad;
+        float prev = distance(collider, from, grad);
+        if (prev < 0) continue; // already inside
+
+        const int steps = 1 + (int)(glm::length(glm::vec2(d.x, d.z)) / terrain.heightfield->getCellSize());
+        for (int s = 1; s <= steps; s++) {
+            const float t = (float)s / steps;
+            const float cur = distance(collider, from + t * d, grad);
+            if (cur < 0) {
+                hit(t - (1.0f / steps) * cur / (cur - prev), collider);
+                break;
+            }
+            prev = cur;
+        }
+    }
+
+    // Gradient of the distance to the collider at the impact
+    normal = glm::vec3(0);
+    if (toi < 1.0f) distance(first, from + toi * d, normal);
+
+    return toi;
+}
@@ -0,0 +1,92 @@
+// Colliders resolved for all particles in one pass, instead of one constraint per particle and collider.
+// To use:
+//    - Add planes, boxes, spheres, cylinders, terrains (heightfields) and static meshes (as signed distance fields).
+//      Particles stay on the positive side of planes and outside of the other shapes
+//    - findContacts once per step: only particles within margin of a collider are kept
+//    - solve once per solver iteration
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+#include "simulation/Constraint.hpp"
+#include "utils/SDF.hpp"
+#include "utils/Heightfield.hpp"
+
+class Colliders {
+public:
+    // dist: distance kept between the particles and the collider
+    uint addPlane(const SemiPlane &plane, float dist = 0.05f);
+    uint addBox(const glm::vec3 &center, const glm::vec3 &halfSize, float dist = 0.0f);
+    uint addSphere(const glm::vec3 &center, float radius);
+    uint addCylinder(const Cylinder &cylinder);
+    uint addSDF(std::shared_ptr<const SDF> sdf, float dist = 0.0f);
+    uint addHeightfield(std::shared_ptr<const Heightfield> heightfield, float dist = 0.0f);
+
+    SemiPlane &getPlane(uint i) { return planes[i].plane; }
+    Cylinder &getCylinder(uint i) { return cylinders[i]; }
+    glm::vec3 &getSphereCenter(uint i) { return spheres[i].center; }
+
+    void setCompliance(const float *alpha) { this->alpha = alpha; }
+
+    bool empty() const { return planes.empty() && boxes.empty() && spheres.empty() && cylinders.empty() && sdfs.empty() && heightfields.empty(); }
+
+    void findContacts(const std::vector<glm::vec3> &pos, float margin);
+    void solve(std::vector<glm::vec3> &pos, const std::vector<float> &w, float dt) const;
+
+    // Fraction in [0, 1] of the motion from -> to before hitting any collider,
+    // and the outward normal of the collider hit first (zero without impact)
+    float timeOfImpact(const glm::vec3 &from, const glm::vec3 &to, glm::vec3 &normal) const;
+
+private:
+    enum Type : uint { PLANE,
+                       BOX,
+                       SPHERE,
+                       CYLINDER,
+                       DISTANCE_FIELD,
+                       HEIGHTFIELD };
+
+    struct PlaneCollider {
+        SemiPlane plane;
+        float dist;
+    };
+
+    struct BoxCollider {
+        glm::vec3 center, halfSize;
+        float dist;
+    };
+
+    struct SphereCollider {
+        glm::vec3 center;
+        float radius;
+    };
+
+    std::vector<PlaneCollider> planes;
+    std::vector<BoxCollider> boxes;
+    std::vector<SphereCollider> spheres;
+    std::vector<Cylinder> cylinders;
+
+    struct SDFCollider {
+        std::shared_ptr<const SDF> sdf;
+        float dist;
+    };
+    std::vector<SDFCollider> sdfs;
+
+    struct HeightfieldCollider {
+        std::shared_ptr<const Heightfield> heightfield;
+        float dist;
+    };
+    std::vector<HeightfieldCollider> heightfields;
+
+    const float *alpha = nullptr;
+
+    // Contacts found by findContacts: colliders (type << 28 | index) of contactParticles[i]
+    // are contacts[contactOffsets[i], contactOffsets[i + 1])
+    std::vector<uint> contactParticles;
+    std::vector<uint> contactOffsets;
+    std::vector<uint> contacts;
+
+    // Signed distance to a collider and its gradient
+    float distance(uint collider, const glm::vec3 &p, glm::vec3 &grad) const;
+};
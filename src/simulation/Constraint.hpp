@@ -4,16 +4,25 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
 #include "utils/utils.hpp"
+#include "utils/Geometry.hpp"
+#include "utils/Arena.hpp"
 
 // Virtual class to handle constraints
 // Children must implement:
 //   - eval: evaluate the constraint
 //   - evalGrad: evaluate the gradient of the constraint
 //   - evalNorm2Grad: compute the denominator of lambda in the solver
+// Constraints created in an Arena::Scope live in that arena with their particle list
 
 struct Constraint {
-    std::vector<uint> particles;
+    std::pmr::vector<uint> particles{Arena::currentResource()};
     const float *alpha;
+
+    virtual ~Constraint() = default;
+
+    static void *operator new(size_t size) { return Arena::allocateObject(size); }
+    static void operator delete(void *p) { Arena::freeObject(p); }
+
     virtual float eval(const std::vector<glm::vec3> &pos) const = 0;
     virtual std::vector<glm::vec3> evalGrad(const std::vector<glm::vec3> &pos) const = 0;
     virtual float evalNorm2Grad(const std::vector<glm::vec3> &pos, const std::vector<float> &w) const = 0;
@@ -328,11 +337,100 @@ struct SphereTriCollisionConstraint : public Constraint {
     }
 };
 
+// Point p stays on the same side of triangle abc, at least thickness away from it
+// side: +1 or -1, side of the triangle where p was when the contact was detected
+struct PointTriangleConstraint : public Constraint {
+    const float thickness;
+    const float side;
+
+    // Cache
+    mutable glm::vec3 n, bary;
+
+    PointTriangleConstraint(uint p, uint a, uint b, uint c, float side, float thickness, const float *alpha) : thickness(thickness), side(side) {
+        particles = {p, a, b, c};
+        this->alpha = alpha;
+    }
+
+    float eval(const std::vector<glm::vec3> &pos) const override {
+        const glm::vec3 &p = pos[particles[0]];
+        const glm::vec3 &a = pos[particles[1]];
+        const glm::vec3 &b = pos[particles[2]];
+        const glm::vec3 &c = pos[particles[3]];
+
+        const glm::vec3 q = utils::closestPointTriangle(p, a, b, c, bary);
+
+        n = glm::cross(b - a, c - a);
+        const float l = glm::length(n);
+        n = l > 1e-12f ? side * n / l : glm::vec3(0);
+
+        return glm::dot(p - q, n) - thickness;
+    }
+
+    bool isSatisfied(float val) const override {
+        return val >= 0;
+    }
+
+    std::vector<glm::vec3> evalGrad(const std::vector<glm::vec3> &pos) const override {
+        return {n, -bary.x * n, -bary.y * n, -bary.z * n};
+    }
+
+    float evalNorm2Grad(const std::vector<glm::vec3> &pos, const std::vector<float> &w) const override {
+        return w[particles[0]] +
+               w[particles[1]] * bary.x * bary.x +
+               w[particles[2]] * bary.y * bary.y +
+               w[particles[3]] * bary.z * bary.z;
+    }
+};
+
+// Edges [a0, a1] and [b0, b1] stay at least thickness away from each other
+// n0: direction from edge b to edge a when the contact was detected, keeps edges from crossing
+struct EdgeEdgeConstraint : public Constraint {
+    const float thickness;
+    const glm::vec3 n0;
+
+    // Cache
+    mutable float s, t;
+
+    EdgeEdgeConstraint(uint a0, uint a1, uint b0, uint b1, const glm::vec3 &n0, float thickness, const float *alpha) : thickness(thickness), n0(n0) {
+        particles = {a0, a1, b0, b1};
+        this->alpha = alpha;
+    }
+
+    float eval(const std::vector<glm::vec3> &pos) const override {
+        const glm::vec3 &a0 = pos[particles[0]];
+        const glm::vec3 &a1 = pos[particles[1]];
+        const glm::vec3 &b0 = pos[particles[2]];
+        const glm::vec3 &b1 = pos[particles[3]];
+
+        utils::closestPointsSegments(a0, a1, b0, b1, s, t);
+
+        const glm::vec3 pa = a0 + s * (a1 - a0);
+        const glm::vec3 pb = b0 + t * (b1 - b0);
+
+        return glm::dot(pa - pb, n0) - thickness;
+    }
+
+    bool isSatisfied(float val) const override {
+        return val >= 0;
+    }
+
+    std::vector<glm::vec3> evalGrad(const std::vector<glm::vec3> &pos) const override {
+        return {(1 - s) * n0, s * n0, -(1 - t) * n0, -t * n0};
+    }
+
+    float evalNorm2Grad(const std::vector<glm::vec3> &pos, const std::vector<float> &w) const override {
+        return w[particles[0]] * (1 - s) * (1 - s) +
+               w[particles[1]] * s * s +
+               w[particles[2]] * (1 - t) * (1 - t) +
+               w[particles[3]] * t * t;
+    }
+};
+
 struct VolumeConstraint : public Constraint {
     float initialVolume;
 
     // Cache
-    mutable std::vector<glm::vec3> gradients;
+    mutable std::pmr::vector<glm::vec3> gradients{Arena::currentResource()};
 
     VolumeConstraint(uint p1, uint p2, uint p3, uint p4, const std::vector<glm::vec3> &pos, const float *alpha) {
         particles = {p1, p2, p3, p4};
@@ -370,7 +468,7 @@ struct VolumeConstraint : public Constraint {
         gradients[2] = glm::cross(v3, v1);
         gradients[3] = glm::cross(v1, v2);
 
-        return gradients;
+        return {gradients.begin(), gradients.end()};
     }
 
     float evalNorm2Grad(const std::vector<glm::vec3> &pos, const std::vector<float> &w) const override {
@@ -447,70 +545,3 @@ struct MeshVolumeConstraint : public Constraint {
         return norm2;
     }
 };
-
-struct DensityConstraint : public Constraint {
-    inline static float d0 = 1000;
-    inline static float h = 0.02;
-    inline static float m = 0.001;
-
-    uint p0;
-
-    // Cache
-    mutable std::vector<glm::vec3> gradients;
-
-    DensityConstraint(uint p0, const float *alpha)
-        : p0(p0) {
-        this->alpha = alpha;
-    }
-
-    static float W_poly6(const glm::vec3 &p1, const glm::vec3 &p2) {
-        float r = glm::length(p1 - p2);
-        if (r > h) return 0;
-
-        return 315.0f / (64.0f * M_PI * pow(h, 9)) * pow(h * h - r * r, 3);
-    }
-
-    static glm::vec3 gW_spiky(const glm::vec3 &p1, const glm::vec3 &p2) {
-        float r = glm::length(p1 - p2);
-        if (r > h) return glm::vec3(0);
-
-        return (float)(-45.0f / (M_PI * pow(h, 6)) * pow(h - r, 2)) * (p1 - p2) / r;
-    }
-
-    float eval(const std::vector<glm::vec3> &pos) const override {
-        float d = 0;
-
-        for (int j : particles) {
-            d += m * W_poly6(pos[p0], pos[j]);
-        }
-
-        return d - d0;
-    }
-
-    bool isSatisfied(float val) const override {
-        return val <= 0;
-    }
-
-    std::vector<glm::vec3> evalGrad(const std::vector<glm::vec3> &pos) const override {
-        if (gradients.size() != particles.size()) {
-            gradients.resize(particles.size());
-        }
-
-        gradients[0] = glm::vec3(0);
-
-        for (int i = 1; i < particles.size(); i++) {
-            gradients[i] = -m * gW_spiky(pos[p0], pos[particles[i]]);
-            gradients[0] += -gradients[i];
-        }
-
-        return gradients;
-    }
-
-    float evalNorm2Grad(const std::vector<glm::vec3> &pos, const std::vector<float> &w) const override {
-        float norm2 = 0.0f;
-        for (size_t i = 0; i < gradients.size(); ++i) {
-            norm2 += w[particles[i]] * glm::length2(gradients[i]);
-        }
-        return norm2;
-    }
-};
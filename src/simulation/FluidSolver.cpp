@@ -0,0 +1,252 @@
+#include "FluidSolver.hpp"
+#include "utils/SpatialGrid.hpp"
+#include <glm/gtx/norm.hpp>
+#include <cmath>
+#include <algorithm>
+
+FluidSolver::FluidSolver(float h, float restDensity, float mass, const float *alpha)
+    : h(h), restDensity(restDensity), mass(mass), alpha(alpha) {
+    h2 = h * h;
+    poly6 = 315.0f / (64.0f * M_PI * pow(h, 9));
+    spikyGrad = -45.0f / (M_PI * pow(h, 6));
+}
+
+uint FluidSolver::hashCell(const glm::ivec3 &cell) const {
+    const uint tableSize = cellStart.size() - 1;
+    return ((uint)cell.x * 73856093u ^ (uint)cell.y * 19349663u ^ (uint)cell.z * 83492791u) % tableSize;
+}
+
+void FluidSolver::addBoundary(const std::vector<glm::vec3> &vertices, const std::vector<uint> &indices, float spacing) {
+    // Regular barycentric samples on each triangle, at most one sample kept per cell of size spacing / 2
+    // (shared edges and small triangles would give duplicates otherwise)
+    SpatialGrid occupied(0.5f * spacing);
+
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const glm::vec3 &a = vertices[indices[t]];
+        const glm::vec3 &b = vertices[indices[t + 1]];
+        const glm::vec3 &c = vertices[indices[t + 2]];
+
+        const float longest = glm::max(glm::distance(a, b), glm::max(glm::distance(b, c), glm::distance(c, a)));
+        const int div = glm::max(1, (int)ceil(longest / spacing));
+
+        for (int i = 0; i <= div; i++) {
+            for (int j = 0; i + j <= div; j++) {
+                const glm::vec3 p = a + (float)i / div * (b - a) + (float)j / div * (c - a);
+                const Coordinates3D cell = occupied.getCell(p);
+                if (occupied.grid.count(cell)) continue;
+
+                occupied.addParticle(p, boundary.size());
+                boundary.push_back(p);
+            }
+        }
+    }
+
+    computeBoundaryVolumes();
+}
+
+void FluidSolver::computeBoundaryVolumes() {
+    // The volume of a boundary particle is the inverse of the kernel sum over its boundary neighbours:
+    // dense samples get small volumes, so the fluid sees the same wall whatever the sampling
+    SpatialGrid grid(h);
+    for (uint b = 0; b < boundary.size(); b++) grid.addParticle(boundary[b], b);
+
+    psi.resize(boundary.size());
+
+#pragma omp parallel for schedule(static)
+    for (int b = 0; b < (int)boundary.size(); b++) {
+        const Coordinates3D cell = grid.getCell(boundary[b]);
+        float sum = 0.0f;
+
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dz = -1; dz <= 1; dz++) {
+                    const auto it = grid.grid.find(Coordinates3D(cell.x + dx, cell.y + dy, cell.z + dz));
+                    if (it == grid.grid.end()) continue;
+                    for (uint k : it->second) sum += W(glm::distance2(boundary[b], boundary[k]));
+                }
+            }
+        }
+
+        psi[b] = restDensity / sum;
+    }
+}
+
+void FluidSolver::findNeighbors(const std::vector<glm::vec3> &pos, float skin) {
+    const uint n = pos.size();
+    const uint total = n + boundary.size();
+    cellSize = h + skin;
+    const float radius2 = cellSize * cellSize;
+
+    // Fluid particles first, then boundary particles
+    auto point = [&](uint i) -> const glm::vec3 & { return i < n ? pos[i] : boundary[i - n]; };
+
+    // Counting sort of the particles by hashed cell
+    cellStart.assign(2 * total + 2, 0);
+    cells.resize(total);
+    std::vector<uint> hashes(total);
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < (int)total; i++) {
+        cells[i] = glm::ivec3(glm::floor(point(i) / cellSize));
+        hashes[i] = hashCell(cells[i]);
+    }
+
+    for (uint i = 0; i < total; i++) cellStart[hashes[i] + 1]++;
+    for (uint c = 1; c < cellStart.size(); c++) cellStart[c] += cellStart[c - 1];
+
+    sorted.resize(total);
+    std::vector<uint> fill(cellStart.begin(), cellStart.end() - 1);
+    for (uint i = 0; i < total; i++) sorted[fill[hashes[i]]++] = i;
+
+    // Copies in sorted order, so that the particles of a cell are contiguous in memory
+    sortedPos.resize(total);
+    sortedCells.resize(total);
+
+#pragma omp parallel for schedule(static)
+    for (int k = 0; k < (int)total; k++) {
+        sortedPos[k] = point(sorted[k]);
+        sortedCells[k] = cells[sorted[k]];
+    }
+
+    // Visit the 27 cells around each particle. Different cells may share a hash: the cell is checked.
+    auto forEachCandidate = [&](uint i, auto &&callback) {
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dz = -1; dz <= 1; dz++) {
+                    const glm::ivec3 cell = cells[i] + glm::ivec3(dx, dy, dz);
+                    const uint hash = hashCell(cell);
+                    for (uint k = cellStart[hash]; k < cellStart[hash + 1]; k++) {
+                        if (sortedCells[k] != cell || glm::distance2(pos[i], sortedPos[k]) >= radius2) continue;
+                        if (sorted[k] != i) callback(sorted[k]);
+                    }
+                }
+            }
+        }
+    };
+
+    // Neighbours are listed by blocks of particles in parallel, then the blocks are concatenated
+    const uint blockSize = 1024;
+    const uint nBlocks = (n + blockSize - 1) / blockSize;
+    std::vector<std::vector<uint>> blockNeighbors(nBlocks);
+    offsets.assign(n + 1, 0);
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int b = 0; b < (int)nBlocks; b++) {
+        std::vector<uint> &list = blockNeighbors[b];
+        for (uint i = b * blockSize; i < std::min(n, (b + 1) * blockSize); i++) {
+            const uint start = list.size();
+            forEachCandidate(i, [&](uint j) { list.push_back(j); });
+            offsets[i + 1] = list.size() - start;
+        }
+    }
+
+    for (uint i = 0; i < n; i++) offsets[i + 1] += offsets[i];
+    neighbors.resize(offsets[n]);
+
+#pragma omp parallel for schedule(static)
+    for (int b = 0; b < (int)nBlocks; b++) {
+        std::copy(blockNeighbors[b].begin(), blockNeighbors[b].end(), neighbors.begin() + offsets[b * blockSize]);
+    }
+
+    density.resize(n);
+    lambda.resize(n);
+    delta.resize(n);
+}
+
+void FluidSolver::solve(std::vector<glm::vec3> &pos, const std::vector<float> &w, float dt) {
+    const int n = pos.size();
+    const float alphaTilde = (alpha ? *alpha : 0.0f) / (dt * dt);
+    const float scale = mass / restDensity;
+
+    // Density and lambda of each particle
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        float rho = mass * W(0.0f);
+        glm::vec3 gradI(0);
+        float sumGrad2 = 0.0f;
+
+        for (uint k = offsets[i]; k < offsets[i + 1]; k++) {
+            const uint j = neighbors[k];
+
+            if (j >= (uint)n) {
+                // Boundary particles add density but do not move
+                const glm::vec3 r = pos[i] - boundary[j - n];
+                const float r2 = glm::length2(r);
+                rho += psi[j - n] * W(r2);
+                gradI += (psi[j - n] / restDensity) * gradW(r, r2);
+                continue;
+            }
+
+            const glm::vec3 r = pos[i] - pos[j];
+            const float r2 = glm::length2(r);
+            if (r2 >= h2) continue;
+
+            rho += mass * W(r2);
+
+            const glm::vec3 gradJ = scale * gradW(r, r2);
+            gradI += gradJ;
+            sumGrad2 += w[j] * glm::length2(gradJ);
+        }
+        sumGrad2 += w[i] * glm::length2(gradI);
+
+        density[i] = rho;
+
+        // Only compression is corrected
+        const float C = glm::max(rho / restDensity - 1.0f, 0.0f);
+        lambda[i] = -C / (sumGrad2 + alphaTilde + 1e-12f);
+    }
+
+    // Position corrections, applied once all of them are known (Jacobi)
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        glm::vec3 d(0);
+
+        for (uint k = offsets[i]; k < offsets[i + 1]; k++) {
+            const uint j = neighbors[k];
+
+            if (j >= (uint)n) {
+                const glm::vec3 r = pos[i] - boundary[j - n];
+                d += (psi[j - n] / mass * lambda[i]) * gradW(r, glm::length2(r));
+                continue;
+            }
+
+            const glm::vec3 r = pos[i] - pos[j];
+            const float r2 = glm::length2(r);
+            if (r2 >= h2) continue;
+
+            d += (lambda[i] + lambda[j]) * gradW(r, r2);
+        }
+
+        delta[i] = w[i] * scale * d;
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        pos[i] += delta[i];
+    }
+}
+
+void FluidSolver::applyViscosity(const std::vector<glm::vec3> &pos, std::vector<glm::vec3> &vel) {
+    if (viscosity <= 0) return;
+
+    const int n = pos.size();
+    std::vector<glm::vec3> dv(n);
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        glm::vec3 sum(0);
+        for (uint k = offsets[i]; k < offsets[i + 1]; k++) {
+            const uint j = neighbors[k];
+            if (j >= (uint)n) continue;
+
+            const float wij = W(glm::distance2(pos[i], pos[j]));
+            if (wij > 0) sum += (mass / density[j]) * (vel[j] - vel[i]) * wij;
+        }
+        dv[i] = viscosity * sum;
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        vel[i] += dv[i];
+    }
+}
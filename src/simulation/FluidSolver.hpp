@@ -0,0 +1,77 @@
+// Position based fluids: one density constraint per particle, solved with parallel Jacobi iterations
+// To use:
+//    - findNeighbors once per step: neighbours within h + skin, so they stay valid while the particles move by less than skin / 2
+//    - solve once per solver iteration (or substep) on the predicted positions
+//    - applyViscosity on the velocities at the end of the step
+// Solids are seen by the fluid through static boundary particles sampled on their surface (Akinci et al. 2012),
+// stored in the same grid as the fluid particles.
+
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include <cmath>
+
+class FluidSolver {
+public:
+    float viscosity = 0.1f; // XSPH
+
+    // h: kernel radius. mass: mass of every particle. alpha: compliance of the density constraints
+    FluidSolver(float h, float restDensity, float mass, const float *alpha);
+
+    // Samples the surface of a triangle mesh, about one boundary particle every spacing
+    void addBoundary(const std::vector<glm::vec3> &vertices, const std::vector<uint> &indices, float spacing);
+
+    void findNeighbors(const std::vector<glm::vec3> &pos, float skin);
+    void solve(std::vector<glm::vec3> &pos, const std::vector<float> &w, float dt);
+    void applyViscosity(const std::vector<glm::vec3> &pos, std::vector<glm::vec3> &vel);
+
+    const std::vector<float> &getDensities() const { return density; }
+    const std::vector<glm::vec3> &getBoundary() const { return boundary; }
+
+private:
+    const float h, restDensity, mass;
+    const float *alpha;
+
+    // Kernel constants
+    float h2;
+    float poly6;     // W(r) = poly6 (h^2 - r^2)^3
+    float spikyGrad; // grad W(r) = spikyGrad (h - r)^2 r / |r|
+
+    float W(float r2) const {
+        if (r2 >= h2) return 0.0f;
+        const float d = h2 - r2;
+        return poly6 * d * d * d;
+    }
+
+    glm::vec3 gradW(const glm::vec3 &r, float r2) const {
+        if (r2 >= h2 || r2 < 1e-12f) return glm::vec3(0);
+        const float len = sqrt(r2);
+        const float d = h - len;
+        return (spikyGrad * d * d / len) * r;
+    }
+
+    // Sorted grid
+    float cellSize;
+    std::vector<uint> cellStart; // hashed cell -> first particle in sorted, size tableSize + 1
+    std::vector<uint> sorted;    // particle ids sorted by hashed cell
+    std::vector<glm::ivec3> cells;
+    std::vector<glm::vec3> sortedPos;
+    std::vector<glm::ivec3> sortedCells;
+
+    // Boundary particles, with psi = restDensity * volume: they count as a fluid particle of mass psi
+    std::vector<glm::vec3> boundary;
+    std::vector<float> psi;
+
+    // Neighbours of fluid particle i: neighbors[offsets[i], offsets[i + 1]). Boundary particle b is n + b.
+    std::vector<uint> offsets;
+    std::vector<uint> neighbors;
+
+    // Per particle data
+    std::vector<float> density;
+    std::vector<float> lambda;
+    std::vector<glm::vec3> delta;
+
+    uint hashCell(const glm::ivec3 &cell) const;
+    void computeBoundaryVolumes();
+};
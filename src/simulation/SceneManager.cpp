@@ -1,29 +1,254 @@
 #include "SceneManager.hpp"
 
-void SceneManager::resetScene() {
-    Scene *newScene = Scenes::createScene(sceneType, scene);
-    newScene->solver->N_ITERATION = scene->solver->N_ITERATION;
+#include <filesystem>
+#include <iostream>
+
+SceneManager::~SceneManager() {
+    discardBuild();
     delete scene;
-    scene = newScene;
+}
+
+void SceneManager::resetScene() {
+    if (building.valid()) {
+        rebuild = true;
+        return;
+    }
+
+    stopTraces();
+    buildStart = std::chrono::steady_clock::now();
+    building = std::async(std::launch::async, [type = sceneType, current = scene] { return Scenes::createScene(type, current); });
+}
+
+void SceneManager::swapBuiltScene(bool wait) {
+    if (!building.valid()) return;
+    if (!wait && building.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+
+    Scene *newScene = nullptr;
+    try {
+        newScene = building.get();
+    } catch (const std::exception &e) {
+        std::cerr << "Could not build the scene: " << e.what() << std::endl;
+    }
+
+    if (newScene) {
+        applyRelease();
+        newScene->solver->N_ITERATION = scene->solver->N_ITERATION;
+        newScene->solver->useCCD = scene->solver->useCCD;
+        delete scene;
+        scene = newScene;
+        shownFrame = -1;
+        onSceneBuilt();
+    }
+
+    if (rebuild) {
+        rebuild = false;
+        resetScene();
+        if (wait) swapBuiltScene(true);
+    }
+}
+
+void SceneManager::discardBuild() {
+    rebuild = false;
+    if (!building.valid()) return;
+
+    try {
+        delete building.get();
+    } catch (const std::exception &) {
+    }
+}
+
+void SceneManager::onSceneBuilt() {
+    scene->solver->saveSnapshot(initialState);
+    savedState.clear();
+    historySize = 0;
+}
+
+void SceneManager::restartScene() {
+    stopReplay();
+    if (traceWriter) traceWriter->addEvent({TraceEvent::RESTART});
+    applyRestart();
     dt = timer.elapsed();
 }
 
+void SceneManager::applyRestart() {
+    restoreState(initialState);
+    historySize = 0;
+}
+
+void SceneManager::restoreState(const Solver::Snapshot &snapshot) {
+    // Snapshots taken during a drag have the grabbed particle fixed: release it after the restore
+    scene->solver->restoreSnapshot(snapshot);
+    applyRelease();
+}
+
+void SceneManager::loadState() {
+    if (savedState.empty()) return;
+    stopTraces();
+    restoreState(savedState);
+}
+
+void SceneManager::rewind() {
+    play = false;
+    if (historySize == 0) return;
+
+    stopTraces();
+    historyEnd = (historyEnd + HISTORY - 1) % HISTORY;
+    historySize--;
+    restoreState(history[historyEnd]);
+}
+
 void SceneManager::updateScene() {
+    swapBuiltScene(false);
+
     dt = timer.elapsed();
-    if (saveVideo) dt = 1.0f / 60;
+    if (fixedDt > 0)
+        dt = fixedDt;
+    else if (saveVideo)
+        dt = 1.0f / 60;
+
+    if (traceReader) {
+        if (traceFrame < traceReader->getFrameCount()) {
+            const TraceFrame &frame = traceReader->getFrame(traceFrame++);
+            for (const TraceEvent &event : frame.events) {
+                if (event.type == TraceEvent::GRAB) applyGrab(event.direction, event.camPos);
+                if (event.type == TraceEvent::MOVE) applyMove(event.direction, event.camPos);
+                if (event.type == TraceEvent::RELEASE) applyRelease();
+                if (event.type == TraceEvent::RESTART) applyRestart();
+            }
+            dt = frame.dt;
+            play = frame.step;
+        } else {
+            std::cout << "Replay finished after " << traceFrame << " frames" << std::endl;
+            stopReplay();
+            play = false;
+        }
+    }
+    if (traceWriter) traceWriter->endFrame(dt, play && !playback);
+
+    if (playback) {
+        if (play) playbackFrame++;
+        if (playbackFrame >= (int)playback->getFrameCount() - 1) play = false;
+        playbackFrame = glm::clamp(playbackFrame, 0, std::max(0, (int)playback->getFrameCount() - 1));
+
+        if (playbackFrame != shownFrame) {
+            scene->solver->setPos(playback->getFrame(playbackFrame));
+            shownFrame = playbackFrame;
+        }
+        return;
+    }
+
     if (play) {
+        // The state before the step, for rewind
+        scene->solver->saveSnapshot(history[historyEnd]);
+        historyEnd = (historyEnd + 1) % HISTORY;
+        historySize = std::min(historySize + 1, HISTORY);
+
         if (!useSubsteps)
             scene->solver->update(dt);
         else
             scene->solver->updateSubsteps(dt);
+
+        if (recorder) recorder->addFrame(scene->getPos());
+    }
+}
+
+void SceneManager::startTrace(const std::string &path) {
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) std::filesystem::create_directories(parent);
+
+    stopTraces();
+    closePlayback();
+
+    TraceSettings settings{static_cast<int32_t>(sceneType), (uint32_t)scene->getPos().size(), scene->solver->N_ITERATION, useSubsteps, scene->solver->useCCD};
+    traceWriter = std::make_unique<TraceWriter>(path, settings);
+    if (!traceWriter->isOpen()) {
+        traceWriter.reset();
+        return;
+    }
+
+    // The replay starts from the initial state too
+    applyRestart();
+}
+
+bool SceneManager::startReplay(const std::string &path) {
+    std::unique_ptr<TraceReader> opened;
+    try {
+        opened = std::make_unique<TraceReader>(path);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+
+    // The replay starts from the scene being built, if any
+    swapBuiltScene(true);
+
+    const TraceSettings &settings = opened->getSettings();
+    if (settings.sceneType != static_cast<int>(sceneType)) setSceneType(settings.sceneType);
+    if (settings.nParticles != scene->getPos().size()) {
+        std::cerr << "The trace was recorded with " << settings.nParticles << " particles, the scene has " << scene->getPos().size() << std::endl;
+        return false;
     }
+
+    stopTraces();
+    closePlayback();
+    scene->solver->N_ITERATION = settings.iterations;
+    scene->solver->useCCD = settings.useCCD;
+    useSubsteps = settings.useSubsteps;
+
+    applyRestart();
+    traceReader = std::move(opened);
+    traceFrame = 0;
+    play = true;
+    return true;
+}
+
+void SceneManager::startRecording(const std::string &path) {
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) std::filesystem::create_directories(parent);
+
+    recorder = std::make_unique<Recorder>(path, scene->getPos().size(), static_cast<int>(sceneType));
+    if (!recorder->isOpen()) recorder.reset();
+}
+
+bool SceneManager::openPlayback(const std::string &path) {
+    // The file being recorded is only complete once the recorder is closed
+    stopRecording();
+
+    std::unique_ptr<Playback> opened;
+    try {
+        opened = std::make_unique<Playback>(path);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+
+    swapBuiltScene(true);
+    if (opened->getSceneType() != static_cast<int>(sceneType)) setSceneType(opened->getSceneType());
+
+    // The parameters of the scene decide its number of particles
+    if (opened->getParticleCount() != scene->getPos().size()) {
+        std::cerr << "The recording has " << opened->getParticleCount() << " particles, the scene " << scene->getPos().size() << std::endl;
+        return false;
+    }
+
+    stopTraces();
+    playback = std::move(opened);
+    playbackFrame = 0;
+    shownFrame = -1;
+    historySize = 0;
+    return true;
 }
 
 void SceneManager::setSceneType(SceneType sceneType) {
+    discardBuild();
     this->sceneType = sceneType;
+    stopRecording();
+    stopTraces();
+    closePlayback();
     delete scene;
     scene = Scenes::createScene(sceneType);
     dt = timer.elapsed();
+    onSceneBuilt();
 }
 
 void SceneManager::drawScene(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap) {
@@ -31,6 +256,24 @@ void SceneManager::drawScene(ShaderProgram &shaderProgram, ShaderProgram &checke
 }
 
 void SceneManager::grab(const glm::vec3 &direction, const glm::vec3 &camPos) {
+    if (traceReader) return; // the replay gives the input
+    if (traceWriter) traceWriter->addEvent({TraceEvent::GRAB, direction, camPos});
+    applyGrab(direction, camPos);
+}
+
+void SceneManager::moveDragged(const glm::vec3 &direction, const glm::vec3 &camPos) {
+    if (traceReader) return;
+    if (traceWriter && grabbedIdx != -1) traceWriter->addEvent({TraceEvent::MOVE, direction, camPos});
+    applyMove(direction, camPos);
+}
+
+void SceneManager::releaseGrabbed() {
+    if (traceReader) return;
+    if (traceWriter && grabbedIdx != -1) traceWriter->addEvent({TraceEvent::RELEASE});
+    applyRelease();
+}
+
+void SceneManager::applyGrab(const glm::vec3 &direction, const glm::vec3 &camPos) {
     initialDistance = MAXFLOAT;
     grabbedIdx = -1;
     const std::vector<glm::vec3> &pos = scene->getPos();
@@ -49,12 +292,12 @@ void SceneManager::grab(const glm::vec3 &direction, const glm::vec3 &camPos) {
     if (grabbedIdx != -1) scene->solver->addFixedPoint(grabbedIdx);
 }
 
-void SceneManager::moveDragged(const glm::vec3 &direction, const glm::vec3 &camPos) {
+void SceneManager::applyMove(const glm::vec3 &direction, const glm::vec3 &camPos) {
     if (grabbedIdx == -1) return;
     scene->solver->setPos(grabbedIdx, camPos + initialDistance * direction);
 }
 
-void SceneManager::releaseGrabbed() {
+void SceneManager::applyRelease() {
     if (grabbedIdx == -1) return;
     scene->solver->removeFixedPoint(grabbedIdx);
     grabbedIdx = -1;
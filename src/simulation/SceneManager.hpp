@@ -6,10 +6,15 @@
 #include "scenes/Scenes.hpp"
 #include "utils/Timer.hpp"
 #include "render/ShadowMap.hpp"
+#include "utils/Recording.hpp"
+#include "utils/InputTrace.hpp"
+#include <memory>
+#include <future>
+#include <chrono>
 
 class SceneManager {
 public:
-    ~SceneManager() { delete scene; }
+    ~SceneManager();
 
     void updateScene();
     void drawScene(ShaderProgram &shaderProgram, ShaderProgram &checkerShaderProgram, ShadowMap &shadowMap);
@@ -17,14 +22,31 @@ public:
     void showSceneConstraintUI() { return scene->showConstraintUI(); }
 
     int *getSolverIterations() { return &scene->solver->N_ITERATION; }
+    bool *getSolverCCD() { return &scene->solver->useCCD; }
 
+    // Rebuilds the scene, for new parameters. The new scene is built on a worker thread while the current one
+    // keeps running, and replaces it at the first update once it is ready (its GL objects are created at its first draw).
     void resetScene();
+    bool isBuilding() const { return building.valid(); }
+    float getBuildTime() const { return std::chrono::duration<float>(std::chrono::steady_clock::now() - buildStart).count(); }
+    // Back to the state of the scene when it was built, without rebuilding it
+    void restartScene();
+
+    // A saved state to try other things from
+    void saveState() { scene->solver->saveSnapshot(savedState); }
+    void loadState();
+    bool hasSavedState() const { return !savedState.empty(); }
+
+    // Goes one step back, as long as the history has steps (HISTORY at most). Pauses the simulation.
+    void rewind();
 
     void invertPlay() { play = !play; }
     void setPlay(bool play) { this->play = play; };
     bool getPlay() const { return play; }
 
     float getFPS() const { return 1.0f / dt; }
+    // Simulated time per update instead of the real time, 0 to disable
+    void setFixedDt(float dt) { fixedDt = dt; }
 
     SceneType getSceneType() const { return sceneType; }
     int getSceneTypeIndex() const { return static_cast<int>(sceneType); }
@@ -36,17 +58,49 @@ public:
     void releaseGrabbed();
     bool isDragging() const { return grabbedIdx != -1; }
 
+    // Recording of the positions after each step
+    void startRecording(const std::string &path);
+    void stopRecording() { recorder.reset(); }
+    bool isRecording() const { return recorder != nullptr; }
+
+    // Playback of a recording: the positions come from the file instead of the solver
+    bool openPlayback(const std::string &path);
+    void closePlayback() { playback.reset(); }
+    bool isPlayingBack() const { return playback != nullptr; }
+    int *getPlaybackFrame() { return &playbackFrame; }
+    int getPlaybackFrameCount() const { return playback ? playback->getFrameCount() : 0; }
+
+    // Trace of the input and time steps from the initial state of the scene, replayed identically.
+    // Rebuilding the scene, loading a state or rewinding ends the trace.
+    void startTrace(const std::string &path);
+    void stopTrace() { traceWriter.reset(); }
+    bool isTracing() const { return traceWriter != nullptr; }
+    bool startReplay(const std::string &path);
+    void stopReplay() { traceReader.reset(); }
+    bool isReplaying() const { return traceReader != nullptr; }
+    uint getReplayFrame() const { return traceFrame; }
+    uint getReplayFrameCount() const { return traceReader ? traceReader->getFrameCount() : 0; }
+
     bool getSaveVideo() { return saveVideo; }
     void setSaveVideo(bool value) { saveVideo = value; }
 
     char saveFilename[128] = "video";
+    bool pipeVideo = false; // encode with ffmpeg while recording, instead of saving PNG files
 
     bool useSubsteps = false;
 
 private:
-    Scene *scene;
+    Scene *scene = nullptr;
+
+    // Scene built by resetScene. The build reads the parameters of the current scene: their UI is disabled meanwhile.
+    std::future<Scene *> building;
+    std::chrono::steady_clock::time_point buildStart;
+    bool rebuild = false; // resetScene during the build: another one once it is done
+    void swapBuiltScene(bool wait);
+    void discardBuild();
     Timer timer;
     float dt = 1;
+    float fixedDt = 0;
 
     bool play = true;
 
@@ -54,6 +108,34 @@ private:
 
     SceneType sceneType = SceneType::CORD;
 
+    // Snapshots of the solver. history is a ring of the last steps, historyEnd is the slot of the next one.
+    static constexpr int HISTORY = 120;
+    Solver::Snapshot initialState;
+    Solver::Snapshot savedState;
+    std::vector<Solver::Snapshot> history = std::vector<Solver::Snapshot>(HISTORY);
+    void restoreState(const Solver::Snapshot &snapshot); // ends a drag
+    int historyEnd = 0, historySize = 0;
+    void onSceneBuilt();
+
+    std::unique_ptr<TraceWriter> traceWriter;
+    std::unique_ptr<TraceReader> traceReader;
+    uint traceFrame = 0;
+    void stopTraces() {
+        stopTrace();
+        stopReplay();
+    }
+
+    // Input applied by the user or by a replay
+    void applyGrab(const glm::vec3 &direction, const glm::vec3 &camPos);
+    void applyMove(const glm::vec3 &direction, const glm::vec3 &camPos);
+    void applyRelease();
+    void applyRestart();
+
+    std::unique_ptr<Recorder> recorder;
+    std::unique_ptr<Playback> playback;
+    int playbackFrame = 0;
+    int shownFrame = -1; // frame of the recording in the solver
+
     // Grab
     float initialDistance;
     int grabbedIdx = -1;
@@ -1,11 +1,18 @@
 #include "Solver.hpp"
 #include "utils/utils.hpp"
 #include "utils/SpatialGrid.hpp"
+#include "mesh/Topology.hpp"
+#include <algorithm>
+#include <cstring>
+
+std::atomic<uint64_t> Solver::lastVersion{0};
 
 Solver::Solver(const std::vector<glm::vec3> &pos, const std::vector<Constraint *> &constraints, float mass)
     : x(pos), nParticles(pos.size()), C(constraints), nConstraints(constraints.size()) {
     v = std::vector<glm::vec3>(nParticles, glm::vec3(0));
     w = std::vector<float>(pos.size(), 1.0f / mass);
+    nCollisionConstraints = nConstraints;
+    touch();
 }
 
 Solver::~Solver() {
@@ -22,6 +29,7 @@ void Solver::addFixedPoint(int index) {
 void Solver::addFixedPoint(int index, const glm::vec3 &pos) {
     w[index] = 0; // infinite mass
     x[index] = pos;
+    touch();
 }
 
 void Solver::removeFixedPoint(int index) {
@@ -31,16 +39,51 @@ void Solver::removeFixedPoint(int index) {
 
 void Solver::setPos(int index, const glm::vec3 &p) {
     x[index] = p;
+    touch();
 }
 
 void Solver::setPos(const std::vector<glm::vec3> &p) {
     x = p;
+    touch();
+}
+
+void Solver::saveSnapshot(Snapshot &snapshot) const {
+    const size_t n = nParticles;
+    snapshot.resize(sizeof(uint32_t) + n * (2 * sizeof(glm::vec3) + sizeof(float)));
+
+    uint8_t *p = snapshot.data();
+    const uint32_t count = nParticles;
+    std::memcpy(p, &count, sizeof(count));
+    p += sizeof(count);
+    std::memcpy(p, x.data(), n * sizeof(glm::vec3));
+    p += n * sizeof(glm::vec3);
+    std::memcpy(p, v.data(), n * sizeof(glm::vec3));
+    p += n * sizeof(glm::vec3);
+    std::memcpy(p, w.data(), n * sizeof(float));
+}
+
+bool Solver::restoreSnapshot(const Snapshot &snapshot) {
+    const size_t n = nParticles;
+    uint32_t count;
+    if (snapshot.size() != sizeof(count) + n * (2 * sizeof(glm::vec3) + sizeof(float))) return false;
+
+    const uint8_t *p = snapshot.data();
+    std::memcpy(&count, p, sizeof(count));
+    if (count != nParticles) return false;
+    p += sizeof(count);
+    std::memcpy(x.data(), p, n * sizeof(glm::vec3));
+    p += n * sizeof(glm::vec3);
+    std::memcpy(v.data(), p, n * sizeof(glm::vec3));
+    p += n * sizeof(glm::vec3);
+    std::memcpy(w.data(), p, n * sizeof(float));
+
+    touch();
+    return true;
 }
 
 void Solver::update(const float dt) {
 
     std::vector<glm::vec3> nextX(x.size());
-    std::vector<float> lambda(nConstraints, 0);
 
     const glm::vec3 g(0, -9.81, 0);
 
@@ -54,15 +97,19 @@ void Solver::update(const float dt) {
 
     if (useRigid) {
         rigidMesh->shapeMatch(nextX);
-        nextX = rigidMesh->getPos();
     }
 
     generateCollisionConstraints();
-    generateFluidNeighbors();
+    generateColliderContacts(dt);
+    generateTriangleCollisions(dt);
+    generateSelfCollisions(dt);
+    generateFluidNeighbors(nextX, dt);
+
+    std::vector<float> lambda(C.size(), 0);
 
     for (int n = 0; n < N_ITERATION; n++) {
         // Solve constraints
-        for (int j = 0; j < nConstraints; j++) {
+        for (int j = 0; j < C.size(); j++) {
             float C_val = C[j]->eval(nextX);
             if (C[j]->isSatisfied(C_val)) continue; // constraint already satisfied
 
@@ -82,16 +129,30 @@ void Solver::update(const float dt) {
 
             if (useRigid) {
                 rigidMesh->shapeMatch(nextX);
-                nextX = rigidMesh->getPos();
             }
         }
+
+        if (fluids) fluids->solve(nextX, w, dt);
+
+        colliders.solve(nextX, w, dt);
+
+        if (useRigid) {
+            rigidMesh->shapeMatch(nextX);
+        }
     }
 
+    applyContinuousCollision(nextX);
+
     // Update
+    bool moved = false;
     for (int i = 0; i < nParticles; i++) {
+        moved |= nextX[i] != x[i];
         v[i] = (nextX[i] - x[i]) / dt;
         x[i] = nextX[i];
     }
+    if (moved) touch();
+
+    if (fluids) fluids->applyViscosity(x, v);
 
     cleanCollisionConstraints();
 }
@@ -104,12 +165,14 @@ void Solver::updateSubsteps(const float dt_) {
 
     const glm::vec3 g(0, -9.81, 0);
 
-    float vmax = useGlobalCollision ? hCollision / 4.0f / dt : MAXFLOAT;
-
     generateCollisionConstraints();
-    generateFluidNeighbors();
+    generateColliderContacts(dt_);
+    generateTriangleCollisions(dt_);
+    generateFluidNeighbors(x, dt_);
 
     for (int n = 0; n < N_ITERATION; n++) {
+        generateSelfCollisions(dt);
+
         // Predict
         for (int i = 0; i < nParticles; i++) {
             if (w[i] != 0)
@@ -147,28 +210,29 @@ void Solver::updateSubsteps(const float dt_) {
             }
         }
 
+        if (fluids) fluids->solve(nextX, w, dt);
+
+        colliders.solve(nextX, w, dt);
+
         applyFriction(nextX, dt);
+        applyContinuousCollision(nextX);
 
         if (useRigid) {
             rigidMesh->shapeMatch(nextX);
-            nextX = rigidMesh->getPos();
         }
 
         // Update
+        bool moved = false;
         for (int i = 0; i < nParticles; i++) {
+            moved |= nextX[i] != x[i];
             v[i] = (nextX[i] - x[i]) / dt;
-            if (useGlobalCollision) {
-                float norm = glm::length(v[i]);
-                if (norm > vmax) {
-                    v[i] *= vmax / norm;
-                    x[i] += v[i] * dt;
-                } else {
-                    x[i] = nextX[i];
-                }
-            } else {
-                x[i] = nextX[i];
-            }
+            x[i] = nextX[i];
         }
+        if (moved) touch();
+
+        if (fluids) fluids->applyViscosity(x, v);
+
+        cleanSelfCollisions();
     }
 
     cleanCollisionConstraints();
@@ -197,8 +261,8 @@ void Solver::generateCollisionConstraints() {
 
                         for (uint p1 : particles) {
                             for (uint p2 : neighborParticles) {
-                                // Add constraint once
-                                if (p1 < p2) {
+                                // Add constraint once, unless the topology already keeps them apart
+                                if (p1 < p2 && !isCollisionExcluded(p1, p2)) {
                                     C.push_back(new MinDistanceConstraint(p1, p2, hCollision, alphaCollision));
                                 }
                             }
@@ -208,22 +272,104 @@ void Solver::generateCollisionConstraints() {
             }
         }
     }
+
+    nCollisionConstraints = C.size();
 }
 
-void Solver::cleanCollisionConstraints() {
-    if (!useGlobalCollision) return;
+void Solver::generateColliderContacts(const float dt) {
+    if (colliders.empty()) return;
+
+    // Keep the particles that may reach a collider during the step, with some slack for the solver corrections
+    float vmax = 0;
+    for (int i = 0; i < nParticles; i++) {
+        vmax = std::max(vmax, glm::length(v[i]));
+    }
+    const float margin = 2.0f * (vmax * dt + 9.81f * dt * dt);
+
+    colliders.findContacts(x, margin);
+}
 
+void Solver::cleanCollisionConstraints() {
     for (int i = nConstraints; i < C.size(); i++) {
         delete C[i];
     }
 
     C.resize(nConstraints);
+    nCollisionConstraints = nConstraints;
 }
 
-void Solver::activateGlobalCollision(float h, float *alphaCollision) {
+void Solver::activateGlobalCollision(float h, float *alphaCollision, int excludedRing) {
     useGlobalCollision = true;
     hCollision = h;
     this->alphaCollision = alphaCollision;
+    buildCollisionFilter(excludedRing);
+}
+
+void Solver::buildCollisionFilter(int ring) {
+    excludedOffsets.assign(nParticles + 1, 0);
+    excluded.clear();
+    if (ring <= 0) return;
+
+    // Constraint graph: particles sharing a small constraint are neighbours.
+    // Colliders (one particle) and global constraints (whole mesh volume) are ignored.
+    std::vector<uint> pairs;
+    for (int j = 0; j < nConstraints; j++) {
+        const auto &particles = C[j]->particles;
+        if (particles.size() < 2 || particles.size() > 4) continue;
+
+        for (uint a = 0; a < particles.size(); a++) {
+            for (uint b = a + 1; b < particles.size(); b++) {
+                if (particles[a] != particles[b]) pairs.insert(pairs.end(), {particles[a], particles[b]});
+            }
+        }
+    }
+
+    std::vector<uint> neighbourOffsets, neighbours;
+    Topology::vertexNeighbours(Topology::uniqueEdges(pairs, 2), nParticles, neighbourOffsets, neighbours);
+
+    // k-ring of each particle by breadth first search
+    std::vector<std::vector<uint>> rings(nParticles);
+
+#pragma omp parallel
+    {
+        std::vector<int> visited(nParticles, -1);
+        std::vector<uint> frontier, next;
+
+#pragma omp for schedule(dynamic, 256)
+        for (int i = 0; i < (int)nParticles; i++) {
+            frontier.assign(1, i);
+            visited[i] = i;
+
+            for (int k = 0; k < ring && !frontier.empty(); k++) {
+                next.clear();
+                for (uint p : frontier) {
+                    for (uint n = neighbourOffsets[p]; n < neighbourOffsets[p + 1]; n++) {
+                        const uint q = neighbours[n];
+                        if (visited[q] == i) continue;
+                        visited[q] = i;
+                        next.push_back(q);
+                        rings[i].push_back(q);
+                    }
+                }
+                std::swap(frontier, next);
+            }
+
+            std::sort(rings[i].begin(), rings[i].end());
+        }
+    }
+
+    for (int i = 0; i < nParticles; i++) {
+        excludedOffsets[i + 1] = excludedOffsets[i] + rings[i].size();
+    }
+    excluded.reserve(excludedOffsets[nParticles]);
+    for (const auto &list : rings) {
+        excluded.insert(excluded.end(), list.begin(), list.end());
+    }
+}
+
+bool Solver::isCollisionExcluded(uint p1, uint p2) const {
+    if (excluded.empty()) return false;
+    return std::binary_search(excluded.begin() + excludedOffsets[p1], excluded.begin() + excludedOffsets[p1 + 1], p2);
 }
 
 void Solver::applyFriction(std::vector<glm::vec3> &nextX, const float dt) {
@@ -231,7 +377,7 @@ void Solver::applyFriction(std::vector<glm::vec3> &nextX, const float dt) {
 
     float d = 20 * dt;
 
-    for (int i = nConstraints; i < C.size(); i++) {
+    for (int i = nConstraints; i < nCollisionConstraints; i++) {
         int p1 = C[i]->particles[0];
         int p2 = C[i]->particles[1];
         glm::vec3 v1 = (nextX[p1] - x[p1]);
@@ -244,46 +390,225 @@ void Solver::applyFriction(std::vector<glm::vec3> &nextX, const float dt) {
     }
 }
 
-void Solver::activateFluids() {
-    useFluids = true;
+void Solver::activateFluids(float h, float restDensity, const float *alpha) {
+    fluids = std::make_unique<FluidSolver>(h, restDensity, 1.0f / w[0], alpha);
 }
 
-void Solver::generateFluidNeighbors() {
-    if (!useFluids) return;
+void Solver::generateFluidNeighbors(const std::vector<glm::vec3> &pos, const float dt) {
+    if (!fluids) return;
 
-    SpatialGrid spatialGrid(DensityConstraint::h);
+    // Neighbours are searched once per step: the skin covers the motion during the step
+    float vmax = 0;
+    for (int i = 0; i < nParticles; i++) {
+        vmax = std::max(vmax, glm::length(v[i]));
+    }
 
-    for (uint i = 0; i < x.size(); ++i) {
-        spatialGrid.addParticle(x[i], i);
-        C[i]->particles = {i};
+    fluids->findNeighbors(pos, 2.0f * (vmax * dt + 9.81f * dt * dt));
+}
+
+void Solver::activateRigid(RigidMesh *mesh) {
+    useRigid = true;
+    rigidMesh = mesh;
+}
+void Solver::activateTriangleCollision(const std::vector<uint> &indices) {
+    triangleBVH = std::make_unique<BVH>(indices, 3, x);
+}
+
+void Solver::addSphereObstacle(glm::vec3 *center, float radius, const float *alpha) {
+    sphereObstacles.push_back({center, radius, alpha});
+}
+
+void Solver::generateTriangleCollisions(const float dt) {
+    if (!triangleBVH || sphereObstacles.empty()) return;
+
+    // Triangles can move by about v * dt during the step: keep the ones that may be reached
+    float vmax = 0;
+    for (int i = 0; i < nParticles; i++) {
+        vmax = std::max(vmax, glm::length(v[i]));
     }
+    const float margin = vmax * dt + 9.81f * dt * dt;
 
-    auto &grid = spatialGrid.grid;
+    triangleBVH->refit(x, margin);
 
-    for (const auto &[cell, particles] : grid) {
-        // Go through 3x3x3 cells
-        for (int dx = -1; dx <= 1; ++dx) {
-            for (int dy = -1; dy <= 1; ++dy) {
-                for (int dz = -1; dz <= 1; ++dz) {
-                    Coordinates3D neighborCell(cell.x + dx, cell.y + dy, cell.z + dz);
+    for (const SphereObstacle &sphere : sphereObstacles) {
+        AABB box(*sphere.center, *sphere.center);
+        box.inflate(sphere.radius);
 
-                    if (grid.find(neighborCell) != grid.end()) {
-                        const auto &neighborParticles = grid[neighborCell];
+        triangleBVH->query(box, [&](uint tri) {
+            const uint *t = triangleBVH->getPrimitive(tri);
+            C.push_back(new SphereTriCollisionConstraint(t[0], t[1], t[2], sphere.center, sphere.radius, sphere.alpha));
+        });
+    }
+}
 
-                        for (uint p1 : particles) {
-                            for (uint p2 : neighborParticles) {
-                                if (p1 == p2) continue;
-                                C[p1]->particles.push_back(p2);
-                            }
-                        }
-                    }
-                }
-            }
+void Solver::activateSelfCollision(const std::vector<uint> &indices, float thickness, const float *alpha) {
+    useSelfCollision = true;
+    selfThickness = thickness;
+    alphaSelfCollision = alpha;
+
+    if (!triangleBVH) triangleBVH = std::make_unique<BVH>(indices, 3, x);
+
+    const std::vector<uint> edges = Topology::uniqueEdges(indices, 3);
+    edgeBVH = std::make_unique<BVH>(edges, 2, x);
+}
+
+void Solver::generateSelfCollisions(const float dt) {
+    selfCollisionStart = C.size();
+    if (!useSelfCollision) return;
+
+    float vmax = 0;
+    for (int i = 0; i < nParticles; i++) {
+        vmax = std::max(vmax, glm::length(v[i]));
+    }
+    // Both sides of a contact can move during the step
+    const float margin = selfThickness + 2.0f * (vmax * dt + 9.81f * dt * dt);
+
+    triangleBVH->refit(x, margin);
+    edgeBVH->refit(x, margin);
+
+    struct PointTriangle {
+        uint p, tri;
+        float side;
+        bool operator<(const PointTriangle &o) const { return p < o.p || (p == o.p && tri < o.tri); }
+    };
+    struct EdgeEdge {
+        uint e, f;
+        glm::vec3 n;
+        bool operator<(const EdgeEdge &o) const { return e < o.e || (e == o.e && f < o.f); }
+    };
+
+    std::vector<PointTriangle> pointTriangles;
+    std::vector<EdgeEdge> edgeEdges;
+
+#pragma omp parallel
+    {
+        std::vector<PointTriangle> localPointTriangles;
+        std::vector<EdgeEdge> localEdgeEdges;
+
+#pragma omp for schedule(dynamic, 64) nowait
+        for (int i = 0; i < (int)nParticles; i++) {
+            triangleBVH->query(AABB(x[i], x[i]), [&](uint tri) {
+                const uint *t = triangleBVH->getPrimitive(tri);
+                if (t[0] == (uint)i || t[1] == (uint)i || t[2] == (uint)i) return; // adjacent
+
+                glm::vec3 bary;
+                const glm::vec3 q = utils::closestPointTriangle(x[i], x[t[0]], x[t[1]], x[t[2]], bary);
+                if (glm::length2(x[i] - q) > margin * margin) return;
+
+                const glm::vec3 n = glm::cross(x[t[1]] - x[t[0]], x[t[2]] - x[t[0]]);
+                localPointTriangles.push_back({(uint)i, tri, glm::dot(x[i] - x[t[0]], n) >= 0 ? 1.0f : -1.0f});
+            });
         }
+
+#pragma omp for schedule(dynamic, 64) nowait
+        for (int e = 0; e < (int)edgeBVH->getPrimitiveCount(); e++) {
+            const uint *a = edgeBVH->getPrimitive(e);
+            AABB box(x[a[0]], x[a[0]]);
+            box.expand(x[a[1]]);
+
+            edgeBVH->query(box, [&](uint f) {
+                if (f <= (uint)e) return; // each pair once
+                const uint *b = edgeBVH->getPrimitive(f);
+                if (a[0] == b[0] || a[0] == b[1] || a[1] == b[0] || a[1] == b[1]) return; // adjacent
+
+                float s, t;
+                utils::closestPointsSegments(x[a[0]], x[a[1]], x[b[0]], x[b[1]], s, t);
+                const glm::vec3 d = (x[a[0]] + s * (x[a[1]] - x[a[0]])) - (x[b[0]] + t * (x[b[1]] - x[b[0]]));
+                const float l = glm::length(d);
+                if (l > margin || l < 1e-8f) return;
+
+                localEdgeEdges.push_back({(uint)e, f, d / l});
+            });
+        }
+
+#pragma omp critical
+        {
+            pointTriangles.insert(pointTriangles.end(), localPointTriangles.begin(), localPointTriangles.end());
+            edgeEdges.insert(edgeEdges.end(), localEdgeEdges.begin(), localEdgeEdges.end());
+        }
+    }
+
+    // Same constraint order whatever the thread scheduling
+    std::sort(pointTriangles.begin(), pointTriangles.end());
+    std::sort(edgeEdges.begin(), edgeEdges.end());
+
+    for (const PointTriangle &c : pointTriangles) {
+        const uint *t = triangleBVH->getPrimitive(c.tri);
+        C.push_back(new PointTriangleConstraint(c.p, t[0], t[1], t[2], c.side, selfThickness, alphaSelfCollision));
+    }
+    for (const EdgeEdge &c : edgeEdges) {
+        const uint *a = edgeBVH->getPrimitive(c.e);
+        const uint *b = edgeBVH->getPrimitive(c.f);
+        C.push_back(new EdgeEdgeConstraint(a[0], a[1], b[0], b[1], c.n, selfThickness, alphaSelfCollision));
     }
 }
 
-void Solver::activateRigid(RigidMesh *mesh) {
-    useRigid = true;
-    rigidMesh = mesh;
-}
\ No newline at end of file
+void Solver::cleanSelfCollisions() {
+    if (!useSelfCollision) return;
+
+    for (int i = selfCollisionStart; i < C.size(); i++) {
+        delete C[i];
+    }
+
+    C.resize(selfCollisionStart);
+}
+
+void Solver::applyContinuousCollision(std::vector<glm::vec3> &nextX) {
+    if (!useCCD || useRigid) return;
+
+    // Fraction of its motion each particle can do before its first impact, and the normal of the contact
+    std::vector<float> toi(nParticles, 1.0f);
+    std::vector<glm::vec3> normals(nParticles, glm::vec3(0));
+
+    // Particle-collider
+    if (!colliders.empty()) {
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < (int)nParticles; i++) {
+            toi[i] = colliders.timeOfImpact(x[i], nextX[i], normals[i]);
+        }
+    }
+
+    // Particle-particle: swept spheres of diameter hCollision. Each particle is bounded by the box of its own motion,
+    // so fast particles do not make the search coarser for the others.
+    if (useGlobalCollision) {
+        std::vector<glm::vec3> swept(x);
+        swept.insert(swept.end(), nextX.begin(), nextX.end());
+        std::vector<uint> segments(2 * nParticles);
+        for (uint i = 0; i < nParticles; i++) {
+            segments[2 * i] = i;
+            segments[2 * i + 1] = nParticles + i;
+        }
+        const BVH sweptBVH(segments, 2, swept);
+
+#pragma omp parallel for schedule(dynamic, 64)
+        for (int i = 0; i < (int)nParticles; i++) {
+            const glm::vec3 di = nextX[i] - x[i];
+
+            // Boxes of both motions, inflated by both radii
+            AABB box(x[i], x[i]);
+            box.expand(nextX[i]);
+            box.inflate(hCollision);
+
+            sweptBVH.query(box, [&](uint j) {
+                if (j == (uint)i || isCollisionExcluded(i, j)) return;
+                const glm::vec3 dj = nextX[j] - x[j];
+                const float t = utils::sweptSphereTimeOfImpact(x[i] - x[j], di - dj, hCollision);
+                if (t < toi[i]) {
+                    toi[i] = t;
+                    normals[i] = glm::normalize(x[i] - x[j] + t * (di - dj));
+                }
+            });
+        }
+    }
+
+    // Stop the motion of particles towards their first contact at the impact, and keep the tangential motion
+    // so they can slide. The rest of the contact is handled by the constraints.
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < (int)nParticles; i++) {
+        if (toi[i] >= 1.0f) continue;
+
+        const glm::vec3 d = nextX[i] - x[i];
+        const float dn = glm::dot(d, normals[i]);
+        if (dn < 0) nextX[i] -= (1.0f - toi[i]) * dn * normals[i];
+    }
+}
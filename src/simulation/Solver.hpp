@@ -2,24 +2,40 @@
 
 #pragma once
 #include "simulation/Constraint.hpp"
+#include "simulation/Colliders.hpp"
+#include "simulation/FluidSolver.hpp"
+#include "utils/BVH.hpp"
 #include <mesh/RigidMesh.hpp>
+#include <memory>
+#include <cstdint>
+#include <atomic>
 
 class Solver {
 public:
     int N_ITERATION = 20;
+    bool useCCD = true; // continuous collision detection
 
     Solver(const std::vector<glm::vec3> &pos, const std::vector<Constraint *> &constraints, float mass = 0.1f);
     ~Solver();
 
-    void activateGlobalCollision(float h, float *alphaCollision);
+    void activateGlobalCollision(float h, float *alphaCollision, int excludedRing = 1);
     void setGlobalCollision(bool val) { useGlobalCollision = val; }
     bool getGlobalCollision() { return useGlobalCollision; }
-    void activateFluids();
+    void activateFluids(float h, float restDensity, const float *alpha);
+    FluidSolver &getFluids() { return *fluids; }
     void activateRigid(RigidMesh *mesh);
+    void activateTriangleCollision(const std::vector<uint> &indices);
+    void addSphereObstacle(glm::vec3 *center, float radius, const float *alpha);
+    void activateSelfCollision(const std::vector<uint> &indices, float thickness, const float *alpha);
+    void setSelfCollision(bool val) { useSelfCollision = val; }
+    bool getSelfCollision() { return useSelfCollision; }
+    Colliders &getColliders() { return colliders; }
 
     void update(const float dt);
     void updateSubsteps(const float dt);
     const std::vector<glm::vec3> &getPos() { return x; }
+    // Changes every time the positions change, and is never shared by two solvers
+    uint64_t getVersion() const { return version; }
 
     void addFixedPoint(int index);
     void addFixedPoint(int index, const glm::vec3 &pos);
@@ -28,25 +44,63 @@ public:
 
     void removeFixedPoint(int index);
 
+    // State between two steps: positions, velocities and inverse masses, in one contiguous blob.
+    // The multipliers and contacts are rebuilt at every step, so they are not part of it.
+    using Snapshot = std::vector<uint8_t>;
+    void saveSnapshot(Snapshot &snapshot) const; // reuses the memory of snapshot
+    bool restoreSnapshot(const Snapshot &snapshot); // false if the number of particles differs
+
 private:
     uint nParticles;
-    uint nConstraints;
+    uint nConstraints;          // static constraints, the following ones are regenerated every step
+    uint nCollisionConstraints; // end of the particle-particle collisions
     std::vector<glm::vec3> x;
     std::vector<glm::vec3> v;
     std::vector<Constraint *> C;
     std::vector<float> w; // inverse of mass
 
+    uint64_t version;
+    static std::atomic<uint64_t> lastVersion; // solvers may be built on another thread
+    void touch() { version = ++lastVersion; }
+
     void generateCollisionConstraints();
+    void buildCollisionFilter(int ring);
+    bool isCollisionExcluded(uint p1, uint p2) const;
+    std::vector<uint> excludedOffsets, excluded; // particles within k constraints of each particle (CSR, sorted)
     void cleanCollisionConstraints();
     void applyFriction(std::vector<glm::vec3> &nextX, const float dt);
+    void applyContinuousCollision(std::vector<glm::vec3> &nextX);
     bool useGlobalCollision = false;
 
-    void generateFluidNeighbors();
-    bool useFluids = false;
+    void generateColliderContacts(const float dt);
+    Colliders colliders; // planes, boxes, spheres and cylinders, solved for all particles at once
+
+    void generateFluidNeighbors(const std::vector<glm::vec3> &pos, const float dt);
+    std::unique_ptr<FluidSolver> fluids; // every particle is a fluid particle
 
     RigidMesh *rigidMesh;
     bool useRigid = false;
 
     float hCollision = 1.0f;
     float *alphaCollision;
+
+    // Sphere obstacles against the triangles of a mesh
+    struct SphereObstacle {
+        glm::vec3 *center;
+        float radius;
+        const float *alpha;
+    };
+
+    void generateTriangleCollisions(const float dt);
+    std::unique_ptr<BVH> triangleBVH;
+    std::vector<SphereObstacle> sphereObstacles;
+
+    // Self collision between the triangles of a mesh: point-triangle and edge-edge contacts
+    void generateSelfCollisions(const float dt);
+    void cleanSelfCollisions();
+    bool useSelfCollision = false;
+    uint selfCollisionStart; // self collisions are regenerated every substep after this index
+    std::unique_ptr<BVH> edgeBVH;
+    float selfThickness;
+    const float *alphaSelfCollision;
 };
\ No newline at end of file
@@ -35,8 +35,18 @@ void UserInterface::show() {
     }
     ImGui::SameLine();
     if (ImGui::Button("Reset")) {
-        sceneManager->resetScene();
+        sceneManager->restartScene();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save state")) {
+        sceneManager->saveState();
+    }
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!sceneManager->hasSavedState());
+    if (ImGui::Button("Load state")) {
+        sceneManager->loadState();
     }
+    ImGui::EndDisabled();
 
     bool saveVideo = sceneManager->getSaveVideo();
     if (ImGui::Checkbox("Save video", &saveVideo)) {
@@ -46,8 +56,54 @@ void UserInterface::show() {
     ImGuiInputTextFlags flags = (saveVideo && sceneManager->getPlay()) ? ImGuiInputTextFlags_ReadOnly : 0;
     ImGui::InputText("Output name", sceneManager->saveFilename, IM_ARRAYSIZE(sceneManager->saveFilename), flags);
 
+    ImGui::BeginDisabled(saveVideo);
+    ImGui::Checkbox("Encode with ffmpeg", &sceneManager->pipeVideo);
+    ImGui::EndDisabled();
+
+    if (ImGui::CollapsingHeader("Recording")) {
+        const std::string path = "data/output/" + std::string(sceneManager->saveFilename) + ".xpbd";
+
+        ImGui::BeginDisabled(sceneManager->isPlayingBack());
+        bool recording = sceneManager->isRecording();
+        if (ImGui::Checkbox("Record simulation", &recording)) {
+            if (recording)
+                sceneManager->startRecording(path);
+            else
+                sceneManager->stopRecording();
+        }
+        ImGui::EndDisabled();
+
+        if (!sceneManager->isPlayingBack()) {
+            if (ImGui::Button("Open recording")) sceneManager->openPlayback(path);
+        } else {
+            ImGui::SliderInt("Frame", sceneManager->getPlaybackFrame(), 0, sceneManager->getPlaybackFrameCount() - 1);
+            if (ImGui::Button("Close recording")) sceneManager->closePlayback();
+        }
+        ImGui::TextDisabled("%s", path.c_str());
+
+        // Input and time steps, to run the same session again
+        const std::string tracePath = "data/output/" + std::string(sceneManager->saveFilename) + ".trace";
+
+        bool tracing = sceneManager->isTracing();
+        if (ImGui::Checkbox("Record input", &tracing)) {
+            if (tracing)
+                sceneManager->startTrace(tracePath);
+            else
+                sceneManager->stopTrace();
+        }
+
+        if (!sceneManager->isReplaying()) {
+            if (ImGui::Button("Replay input")) sceneManager->startReplay(tracePath);
+        } else {
+            ImGui::Text("Replay: frame %u / %u", sceneManager->getReplayFrame(), sceneManager->getReplayFrameCount());
+            if (ImGui::Button("Stop replay")) sceneManager->stopReplay();
+        }
+        ImGui::TextDisabled("%s", tracePath.c_str());
+    }
+
     if (ImGui::CollapsingHeader("Solver parameters")) {
         ImGui::Checkbox("Use substeps", &sceneManager->useSubsteps);
+        ImGui::Checkbox("Continuous collision", sceneManager->getSolverCCD());
         ImGui::InputInt("Iterations", sceneManager->getSolverIterations(), 1, 10);
         if (*sceneManager->getSolverIterations() < 1) {
             *sceneManager->getSolverIterations() = 1;
@@ -56,6 +112,14 @@ void UserInterface::show() {
 
     ImGui::Text("Scene Parameters");
 
+    // The parameters are read while the new scene is built
+    const bool building = sceneManager->isBuilding();
+    if (building) {
+        const char *dots[] = {"", ".", "..", "..."};
+        ImGui::Text("Building the scene%s %.1f s", dots[(int)(2 * ImGui::GetTime()) % 4], sceneManager->getBuildTime());
+    }
+    ImGui::BeginDisabled(building);
+
     if (sceneManager->showSceneUI()) {
         sceneManager->resetScene();
     }
@@ -63,6 +127,8 @@ void UserInterface::show() {
     if (ImGui::CollapsingHeader("Constraints"))
         sceneManager->showSceneConstraintUI();
 
+    ImGui::EndDisabled();
+
     ImGui::End();
 
     ImGui::Render();
@@ -0,0 +1,150 @@
+// Memory of the constraints of a scene, released at once with the arena
+// To use:
+//    - Keep an Arena alive as long as the objects built in it, and open an Arena::Scope(arena) while building them
+//    - In the scope, the constraints created with new (and their particle lists) are placed one after the other in the arena.
+//      Deleting them runs their destructors only.
+//    - reserve(bytes) makes the next allocations contiguous, see objectSize
+// The current arena is per thread: constraints created elsewhere (solver contacts, other threads) stay on the heap.
+// Each scope allocates from its own slice of a chunk without locking: parallel loops fill the arena if each thread
+// opens its own scope. Only taking a new slice, or allocating outside of a scope of the arena, locks a mutex.
+
+#pragma once
+
+#include <memory_resource>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+class Arena : public std::pmr::memory_resource {
+public:
+    Arena(size_t chunkSize = 1 << 16) : nextChunkSize(chunkSize) {}
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // Makes sure the next allocations, up to this many bytes, go to a single chunk (less the end of the last slice
+    // of each thread, when several threads fill it)
+    void reserve(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if ((size_t)(end - head) < bytes) addChunk(bytes);
+    }
+
+    // Room taken by an object of type T allocated with allocateObject, with extraBytes of its own, to reserve
+    template <typename T>
+    static size_t objectSize(size_t extraBytes = 0) {
+        return roundUp(sizeof(T) + HEADER) + roundUp(extraBytes);
+    }
+
+    // Bytes taken from the chunks, with the unused end of the slices
+    size_t getUsed() const { return used; }
+
+    // Sets the current arena of the thread, until the end of the scope
+    class Scope {
+    public:
+        Scope(Arena &arena) : arena(&arena), previous(current) { current = this; }
+        ~Scope() { current = previous; }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        friend class Arena;
+
+        Arena *arena;
+        Scope *previous;
+        char *head = nullptr; // slice of this thread
+        char *end = nullptr;
+    };
+
+    // Resource of the current arena, or the heap outside of any scope
+    static std::pmr::memory_resource *currentResource() {
+        return current ? static_cast<std::pmr::memory_resource *>(current->arena) : std::pmr::new_delete_resource();
+    }
+
+    // For the operator new and delete of a class. A header before the object tells where it lives.
+    static void *allocateObject(size_t size) {
+        char *block;
+        if (current) {
+            block = static_cast<char *>(current->arena->allocate(size + HEADER, HEADER));
+            *reinterpret_cast<uintptr_t *>(block) = 1;
+        } else {
+            block = static_cast<char *>(::operator new(size + HEADER));
+            *reinterpret_cast<uintptr_t *>(block) = 0;
+        }
+        return block + HEADER;
+    }
+
+    static void freeObject(void *p) {
+        if (!p) return;
+        char *block = static_cast<char *>(p) - HEADER;
+        if (*reinterpret_cast<uintptr_t *>(block) == 0) ::operator delete(block);
+    }
+
+private:
+    static constexpr size_t HEADER = alignof(std::max_align_t);
+    static constexpr size_t SLICE = 1 << 14;
+
+    inline static thread_local Scope *current = nullptr;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char *head = nullptr;
+    char *end = nullptr;
+    size_t nextChunkSize;
+    size_t used = 0;
+
+    static size_t roundUp(size_t bytes) { return (bytes + HEADER - 1) / HEADER * HEADER; }
+
+    // Aligned block of [head, end), or nullptr if it does not fit. head moves past it.
+    static void *bump(char *&head, char *end, size_t bytes, size_t alignment) {
+        const uintptr_t address = (reinterpret_cast<uintptr_t>(head) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (!head || address + bytes > reinterpret_cast<uintptr_t>(end)) return nullptr;
+        head = reinterpret_cast<char *>(address + bytes);
+        return reinterpret_cast<void *>(address);
+    }
+
+    void addChunk(size_t size) {
+        chunks.emplace_back(new char[size]);
+        head = chunks.back().get();
+        end = head + size;
+        nextChunkSize = std::max(nextChunkSize, size) * 2;
+    }
+
+    // Block of the shared chunk, with the mutex locked
+    void *take(size_t bytes, size_t alignment) {
+        void *block = bump(head, end, bytes, alignment);
+        if (!block) {
+            addChunk(std::max(nextChunkSize, bytes + alignment));
+            block = bump(head, end, bytes, alignment);
+        }
+        used += bytes;
+        return block;
+    }
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        Scope *scope = current;
+        if (!scope || scope->arena != this) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return take(bytes, alignment);
+        }
+
+        if (void *block = bump(scope->head, scope->end, bytes, alignment)) return block;
+
+        // New slice for the thread, the rest of the chunk if it is smaller
+        std::lock_guard<std::mutex> lock(mutex);
+        const size_t needed = bytes + alignment;
+        const size_t left = head ? end - head : 0;
+        const size_t slice = left >= needed ? std::min(left, std::max(SLICE, needed)) : std::max(SLICE, needed);
+        scope->head = static_cast<char *>(take(slice, 1));
+        scope->end = scope->head + slice;
+        return bump(scope->head, scope->end, bytes, alignment);
+    }
+
+    // Freed with the arena
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
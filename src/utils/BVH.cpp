@@ -0,0 +1,92 @@
+#include "BVH.hpp"
+#include <algorithm>
+#include <numeric>
+
+BVH::BVH(const std::vector<uint> &indices, uint arity, const std::vector<glm::vec3> &pos)
+    : indices(indices), arity(arity) {
+
+    const uint n = indices.size() / arity;
+
+    primitives.resize(n);
+    std::iota(primitives.begin(), primitives.end(), 0);
+    primitiveBoxes.resize(n);
+
+    std::vector<glm::vec3> centroids(n);
+    for (uint i = 0; i < n; i++) {
+        centroids[i] = primitiveBox(i, pos).center();
+    }
+
+    if (n == 0) return;
+
+    nodes.reserve(2 * n / LEAF_SIZE + 1);
+    build(0, n, 0, centroids);
+    refit(pos);
+}
+
+AABB BVH::primitiveBox(uint primitive, const std::vector<glm::vec3> &pos) const {
+    AABB box;
+    for (uint k = 0; k < arity; k++) {
+        box.expand(pos[indices[primitive * arity + k]]);
+    }
+    return box;
+}
+
+int BVH::build(uint start, uint end, uint depth, const std::vector<glm::vec3> &centroids) {
+    const int id = nodes.size();
+    nodes.emplace_back();
+
+    if (levels.size() <= depth) levels.resize(depth + 1);
+    levels[depth].push_back(id);
+
+    if (end - start <= LEAF_SIZE) {
+        nodes[id].start = start;
+        nodes[id].count = end - start;
+        return id;
+    }
+
+    // Split on the longest axis of the centroids at the median
+    AABB centroidBox;
+    for (uint i = start; i < end; i++) {
+        centroidBox.expand(centroids[primitives[i]]);
+    }
+
+    const glm::vec3 extent = centroidBox.max - centroidBox.min;
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    const uint mid = (start + end) / 2;
+    std::nth_element(primitives.begin() + start, primitives.begin() + mid, primitives.begin() + end,
+                     [&](uint a, uint b) { return centroids[a][axis] < centroids[b][axis]; });
+
+    const int left = build(start, mid, depth + 1, centroids);
+    const int right = build(mid, end, depth + 1, centroids);
+    nodes[id].left = left;
+    nodes[id].right = right;
+
+    return id;
+}
+
+void BVH::refit(const std::vector<glm::vec3> &pos, float margin) {
+    // Children are always one level deeper than their parent
+    for (int depth = levels.size() - 1; depth >= 0; depth--) {
+        const std::vector<uint> &level = levels[depth];
+
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < (int)level.size(); i++) {
+            Node &node = nodes[level[i]];
+            node.box = AABB();
+
+            if (node.count > 0) {
+                for (uint j = node.start; j < node.start + node.count; j++) {
+                    primitiveBoxes[j] = primitiveBox(primitives[j], pos);
+                    primitiveBoxes[j].inflate(margin);
+                    node.box.expand(primitiveBoxes[j]);
+                }
+            } else {
+                node.box.expand(nodes[node.left].box);
+                node.box.expand(nodes[node.right].box);
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+// Bounding volume hierarchy over mesh primitives (triangles, edges or points) to accelerate collision detection
+// To use:
+//    - Build it once with the indices of the primitives and the number of vertices per primitive
+//    - Call refit with the current positions every time they change (the topology of the tree is kept)
+//    - Use query to get the primitives whose box overlaps a given box
+
+#pragma once
+
+#include <vector>
+#include <cfloat>
+#include <glm/glm.hpp>
+
+struct AABB {
+    glm::vec3 min = glm::vec3(FLT_MAX);
+    glm::vec3 max = glm::vec3(-FLT_MAX);
+
+    AABB() {}
+    AABB(const glm::vec3 &min, const glm::vec3 &max) : min(min), max(max) {}
+
+    void expand(const glm::vec3 &p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+
+    void expand(const AABB &other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    void inflate(float r) {
+        min -= glm::vec3(r);
+        max += glm::vec3(r);
+    }
+
+    bool overlaps(const AABB &other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    glm::vec3 center() const { return 0.5f * (min + max); }
+};
+
+class BVH {
+public:
+    BVH(const std::vector<uint> &indices, uint arity, const std::vector<glm::vec3> &pos);
+
+    // Recompute the boxes bottom-up, one depth level at a time. Boxes are inflated by margin.
+    void refit(const std::vector<glm::vec3> &pos, float margin = 0.0f);
+
+    // Calls callback(primitiveIndex) for every primitive whose box overlaps box
+    template <typename Callback>
+    void query(const AABB &box, Callback &&callback) const {
+        if (nodes.empty()) return;
+
+        int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0) {
+            const Node &node = nodes[stack[--top]];
+            if (!node.box.overlaps(box)) continue;
+
+            if (node.count > 0) {
+                for (uint i = node.start; i < node.start + node.count; i++) {
+                    if (primitiveBoxes[i].overlaps(box)) callback(primitives[i]);
+                }
+            } else {
+                stack[top++] = node.left;
+                stack[top++] = node.right;
+            }
+        }
+    }
+
+    uint getPrimitiveCount() const { return primitives.size(); }
+    uint getArity() const { return arity; }
+    const uint *getPrimitive(uint i) const { return &indices[i * arity]; }
+    const AABB &getBounds() const { return nodes[0].box; }
+
+private:
+    // Leaf if count > 0, primitives[start, start + count) are inside
+    struct Node {
+        AABB box;
+        int left = -1, right = -1;
+        uint start = 0, count = 0;
+    };
+
+    static constexpr uint LEAF_SIZE = 4;
+
+    std::vector<Node> nodes;
+    std::vector<uint> indices;
+    uint arity;
+
+    std::vector<uint> primitives;     // primitive ids, ordered by leaf
+    std::vector<AABB> primitiveBoxes; // same order as primitives
+
+    std::vector<std::vector<uint>> levels; // node ids grouped by depth
+
+    AABB primitiveBox(uint primitive, const std::vector<glm::vec3> &pos) const;
+    int build(uint start, uint end, uint depth, const std::vector<glm::vec3> &centroids);
+};
@@ -0,0 +1,123 @@
+// Closest point queries between points, segments and triangles, used by the collision detection.
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+namespace utils {
+
+// Closest point to p on triangle abc, bary receives its barycentric coordinates
+inline glm::vec3 closestPointTriangle(const glm::vec3 &p, const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, glm::vec3 &bary) {
+    const glm::vec3 ab = b - a;
+    const glm::vec3 ac = c - a;
+    const glm::vec3 ap = p - a;
+
+    const float d1 = glm::dot(ab, ap);
+    const float d2 = glm::dot(ac, ap);
+    if (d1 <= 0 && d2 <= 0) {
+        bary = {1, 0, 0};
+        return a;
+    }
+
+    const glm::vec3 bp = p - b;
+    const float d3 = glm::dot(ab, bp);
+    const float d4 = glm::dot(ac, bp);
+    if (d3 >= 0 && d4 <= d3) {
+        bary = {0, 1, 0};
+        return b;
+    }
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        const float v = d1 / (d1 - d3);
+        bary = {1 - v, v, 0};
+        return a + v * ab;
+    }
+
+    const glm::vec3 cp = p - c;
+    const float d5 = glm::dot(ab, cp);
+    const float d6 = glm::dot(ac, cp);
+    if (d6 >= 0 && d5 <= d6) {
+        bary = {0, 0, 1};
+        return c;
+    }
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        const float w = d2 / (d2 - d6);
+        bary = {1 - w, 0, w};
+        return a + w * ac;
+    }
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+        const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        bary = {0, 1 - w, w};
+        return b + w * (c - b);
+    }
+
+    const float denom = 1.0f / (va + vb + vc);
+    const float v = vb * denom;
+    const float w = vc * denom;
+    bary = {1 - v - w, v, w};
+    return a + ab * v + ac * w;
+}
+
+// Closest points between segments [p1, q1] and [p2, q2]: p1 + s (q1 - p1) and p2 + t (q2 - p2)
+inline void closestPointsSegments(const glm::vec3 &p1, const glm::vec3 &q1, const glm::vec3 &p2, const glm::vec3 &q2, float &s, float &t) {
+    const glm::vec3 d1 = q1 - p1;
+    const glm::vec3 d2 = q2 - p2;
+    const glm::vec3 r = p1 - p2;
+    const float a = glm::length2(d1);
+    const float e = glm::length2(d2);
+    const float f = glm::dot(d2, r);
+
+    if (a <= 1e-12f && e <= 1e-12f) {
+        s = t = 0;
+        return;
+    }
+    if (a <= 1e-12f) {
+        s = 0;
+        t = glm::clamp(f / e, 0.0f, 1.0f);
+        return;
+    }
+
+    const float c = glm::dot(d1, r);
+    if (e <= 1e-12f) {
+        t = 0;
+        s = glm::clamp(-c / a, 0.0f, 1.0f);
+        return;
+    }
+
+    const float b = glm::dot(d1, d2);
+    const float denom = a * e - b * b;
+
+    s = denom > 1e-12f ? glm::clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+    t = (b * s + f) / e;
+
+    if (t < 0) {
+        t = 0;
+        s = glm::clamp(-c / a, 0.0f, 1.0f);
+    } else if (t > 1) {
+        t = 1;
+        s = glm::clamp((b - c) / a, 0.0f, 1.0f);
+    }
+}
+
+// First t in [0, 1] where |p + t d| = r, for a point at relative position p moving by d.
+// Returns 1 if there is no impact or if the point already starts inside.
+inline float sweptSphereTimeOfImpact(const glm::vec3 &p, const glm::vec3 &d, float r) {
+    const float c = glm::length2(p) - r * r;
+    const float b = glm::dot(p, d);
+    if (c < 0 || b >= 0) return 1.0f; // inside or moving away
+
+    const float a = glm::length2(d);
+    const float disc = b * b - a * c;
+    if (disc < 0) return 1.0f;
+
+    const float t = (-b - sqrt(disc)) / a;
+    return t < 1.0f ? glm::max(t, 0.0f) : 1.0f;
+}
+
+} // namespace utils
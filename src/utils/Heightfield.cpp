@@ -0,0 +1,93 @@
+#include "Heightfield.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <cctype>
+
+Heightfield::Heightfield(int nx, int nz, float cellSize, const std::vector<float> &heights)
+    : nx(nx), nz(nz), cellSize(cellSize), heights(heights) {
+    if (nx < 2 || nz < 2 || heights.size() != (size_t)nx * nz) {
+        throw std::runtime_error("Heightfield needs at least 2x2 heights.");
+    }
+    origin = -0.5f * cellSize * glm::vec2(nx - 1, nz - 1);
+}
+
+namespace {
+
+// Next header token of a PGM file, skipping comments
+std::string readToken(std::istream &file) {
+    std::string token;
+    char c;
+    while (file.get(c)) {
+        if (c == '#') {
+            while (file.get(c) && c != '\n') {}
+        } else if (std::isspace((unsigned char)c)) {
+            if (!token.empty()) break;
+        } else {
+            token += c;
+        }
+    }
+    return token;
+}
+
+} // namespace
+
+std::shared_ptr<Heightfield> Heightfield::createFromPGM(const std::string &filePath, float cellSize, float minHeight, float maxHeight) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filePath);
+    }
+
+    if (readToken(file) != "P5") {
+        throw std::runtime_error("File is not a binary PGM.");
+    }
+
+    const int width = std::stoi(readToken(file));
+    const int height = std::stoi(readToken(file));
+    const int maxVal = std::stoi(readToken(file));
+    if (width < 2 || height < 2) {
+        throw std::runtime_error("PGM heightfield needs at least 2x2 pixels: " + filePath);
+    }
+    if (maxVal <= 0 || maxVal > 65535) {
+        throw std::runtime_error("Invalid PGM maximum value: " + filePath);
+    }
+    const int bytes = maxVal < 256 ? 1 : 2;
+
+    std::vector<float> heights((size_t)width * height);
+    std::vector<unsigned char> row((size_t)width * bytes);
+
+    for (int j = 0; j < height; j++) {
+        if (!file.read(reinterpret_cast<char *>(row.data()), row.size())) {
+            throw std::runtime_error("Truncated PGM file: " + filePath);
+        }
+
+        for (int i = 0; i < width; i++) {
+            // 16 bits values are big endian
+            const int value = bytes == 1 ? row[i] : (row[2 * i] << 8 | row[2 * i + 1]);
+            heights[(size_t)j * width + i] = minHeight + (maxHeight - minHeight) * value / maxVal;
+        }
+    }
+
+    return std::make_shared<Heightfield>(width, height, cellSize, heights);
+}
+
+float Heightfield::height(float x, float z, glm::vec3 &normal) const {
+    const float gx = glm::clamp((x - origin.x) / cellSize, 0.0f, (float)(nx - 1));
+    const float gz = glm::clamp((z - origin.y) / cellSize, 0.0f, (float)(nz - 1));
+
+    const int i = glm::min((int)gx, nx - 2);
+    const int j = glm::min((int)gz, nz - 2);
+    const float fx = gx - i;
+    const float fz = gz - j;
+
+    const float h00 = heights[j * nx + i];
+    const float h10 = heights[j * nx + i + 1];
+    const float h01 = heights[(j + 1) * nx + i];
+    const float h11 = heights[(j + 1) * nx + i + 1];
+
+    const float dhdx = glm::mix(h10 - h00, h11 - h01, fz) / cellSize;
+    const float dhdz = glm::mix(h01 - h00, h11 - h10, fx) / cellSize;
+    normal = glm::normalize(glm::vec3(-dhdx, 1.0f, -dhdz));
+
+    return glm::mix(glm::mix(h00, h10, fx), glm::mix(h01, h11, fx), fz);
+}
@@ -0,0 +1,34 @@
+// Terrain as a regular grid of heights on the xz plane, centered on the origin
+// To use:
+//    - Load it from a PGM heightmap, such as data/terrain/hills.pgm
+//    - height gives the bilinear height and the normal at any (x, z), in O(1)
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <glm/glm.hpp>
+
+class Heightfield {
+public:
+    // nx * nz heights, x fastest
+    Heightfield(int nx, int nz, float cellSize, const std::vector<float> &heights);
+
+    // Binary PGM (P5, 8 or 16 bits), read one row at a time. Black is minHeight, white is maxHeight.
+    static std::shared_ptr<Heightfield> createFromPGM(const std::string &filePath, float cellSize, float minHeight, float maxHeight);
+
+    // Height and normal of the terrain below (x, z). The border is extended outside of the grid.
+    float height(float x, float z, glm::vec3 &normal) const;
+
+    int getSizeX() const { return nx; }
+    int getSizeZ() const { return nz; }
+    float getCellSize() const { return cellSize; }
+    glm::vec3 getVertex(int i, int j) const { return {origin.x + i * cellSize, heights[j * nx + i], origin.y + j * cellSize}; }
+
+private:
+    int nx, nz;
+    float cellSize;
+    glm::vec2 origin; // (x, z) of the first height
+    std::vector<float> heights;
+};
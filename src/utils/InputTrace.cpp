@@ -0,0 +1,84 @@
+#include "InputTrace.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+constexpr char MAGIC[8] = {'X', 'P', 'B', 'D', 'T', 'R', 'C', '1'};
+
+template <typename T>
+void put(std::ofstream &file, const T &value) {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool get(const std::vector<char> &data, size_t &offset, T &value) {
+    if (offset + sizeof(T) > data.size()) return false;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+TraceWriter::TraceWriter(const std::string &path, const TraceSettings &settings) : file(path, std::ios::binary) {
+    if (!file.is_open()) {
+        std::cerr << "Could not create trace: " << path << std::endl;
+        return;
+    }
+
+    file.write(MAGIC, sizeof(MAGIC));
+    put(file, settings.sceneType);
+    put(file, settings.nParticles);
+    put(file, settings.iterations);
+    put(file, settings.useSubsteps);
+    put(file, settings.useCCD);
+}
+
+void TraceWriter::endFrame(float dt, bool step) {
+    if (!file.is_open()) return;
+
+    put(file, dt);
+    put(file, (uint8_t)step);
+    put(file, (uint16_t)events.size());
+    for (const TraceEvent &event : events) {
+        put(file, event.type);
+        put(file, event.direction);
+        put(file, event.camPos);
+    }
+
+    events.clear();
+}
+
+TraceReader::TraceReader(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("Could not open trace: " + path);
+    const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t offset = sizeof(MAGIC);
+    const bool valid = data.size() >= sizeof(MAGIC) && std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0 &&
+                       get(data, offset, settings.sceneType) && get(data, offset, settings.nParticles) && get(data, offset, settings.iterations) &&
+                       get(data, offset, settings.useSubsteps) && get(data, offset, settings.useCCD);
+    if (!valid) throw std::runtime_error("Not a trace: " + path);
+
+    // A frame cut by the end of the file (the application was killed) is dropped
+    while (true) {
+        TraceFrame frame;
+        uint8_t step;
+        uint16_t nEvents;
+        if (!get(data, offset, frame.dt) || !get(data, offset, step) || !get(data, offset, nEvents)) break;
+        frame.step = step != 0;
+
+        frame.events.resize(nEvents);
+        bool complete = true;
+        for (TraceEvent &event : frame.events) {
+            complete = complete && get(data, offset, event.type) && get(data, offset, event.direction) && get(data, offset, event.camPos);
+        }
+        if (!complete) break;
+
+        frames.push_back(std::move(frame));
+    }
+}
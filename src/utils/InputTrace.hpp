@@ -0,0 +1,64 @@
+// Input of an interactive session, frame by frame, to run it again identically
+// To use:
+//    - TraceWriter: addEvent for each input of the frame, then endFrame with its time step
+//    - TraceReader: getFrame gives the time step and the input of each frame
+// The floats are stored as they were given, so that a replay makes the same steps on the same build.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+struct TraceEvent {
+    enum Type : uint8_t { GRAB, MOVE, RELEASE, RESTART };
+
+    Type type;
+    glm::vec3 direction = glm::vec3(0); // ray of the mouse, for GRAB and MOVE
+    glm::vec3 camPos = glm::vec3(0);
+};
+
+// State needed to start the replay like the recording
+struct TraceSettings {
+    int32_t sceneType;
+    uint32_t nParticles; // the parameters of the scene are not stored, only checked through this
+    int32_t iterations;
+    uint8_t useSubsteps;
+    uint8_t useCCD;
+};
+
+struct TraceFrame {
+    float dt;
+    bool step; // false while paused
+    std::vector<TraceEvent> events;
+};
+
+class TraceWriter {
+public:
+    TraceWriter(const std::string &path, const TraceSettings &settings);
+
+    void addEvent(const TraceEvent &event) { events.push_back(event); }
+    void endFrame(float dt, bool step);
+
+    bool isOpen() const { return file.is_open(); }
+
+private:
+    std::ofstream file;
+    std::vector<TraceEvent> events;
+};
+
+class TraceReader {
+public:
+    // Throws std::runtime_error if the file is not a trace
+    TraceReader(const std::string &path);
+
+    const TraceSettings &getSettings() const { return settings; }
+    uint getFrameCount() const { return frames.size(); }
+    const TraceFrame &getFrame(uint frame) const { return frames[frame]; }
+
+private:
+    TraceSettings settings;
+    std::vector<TraceFrame> frames;
+};
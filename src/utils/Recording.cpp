@@ -0,0 +1,224 @@
+#include "Recording.hpp"
+
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char MAGIC[8] = {'X', 'P', 'B', 'D', 'R', 'E', 'C', '1'};
+
+struct Header {
+    char magic[8];
+    uint32_t nParticles;
+    int32_t sceneType;
+    uint32_t keyInterval;
+    uint32_t reserved;
+};
+
+// At the end of the file, after the offsets of the frames
+struct Footer {
+    uint64_t indexOffset;
+    uint64_t frameCount;
+};
+
+enum FrameType : uint8_t { KEY = 0, DELTA = 1 };
+
+const float QUANTUM = 65535.0f;
+
+void writeVarint(std::vector<uint8_t> &buffer, uint32_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(value | 0x80);
+        value >>= 7;
+    }
+    buffer.push_back(value);
+}
+
+// Never reads at or after end: a truncated value stops there
+uint32_t readVarint(const uint8_t *&p, const uint8_t *end) {
+    uint32_t value = 0;
+    for (int shift = 0; p < end && shift < 32; shift += 7) {
+        const uint8_t byte = *p++;
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) break;
+    }
+    return value;
+}
+
+const size_t FRAME_HEADER = 1 + 6 * sizeof(float); // type, then bounding box
+
+} // namespace
+
+Recorder::Recorder(const std::string &path, uint nParticles, int sceneType)
+    : file(path, std::ios::binary), nParticles(nParticles), previous(3 * nParticles), quantized(3 * nParticles) {
+    if (!file.is_open()) {
+        std::cerr << "Could not create recording: " << path << std::endl;
+        return;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.nParticles = nParticles;
+    header.sceneType = sceneType;
+    header.keyInterval = KEY_INTERVAL;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+Recorder::~Recorder() {
+    if (!file.is_open()) return;
+
+    Footer footer{(uint64_t)file.tellp(), offsets.size()};
+    file.write(reinterpret_cast<const char *>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char *>(&footer), sizeof(footer));
+}
+
+void Recorder::addFrame(const std::vector<glm::vec3> &pos) {
+    if (!file.is_open() || pos.size() != nParticles) return;
+
+    glm::vec3 bbMin(INFINITY), bbMax(-INFINITY);
+    for (const glm::vec3 &p : pos) {
+        bbMin = glm::min(bbMin, p);
+        bbMax = glm::max(bbMax, p);
+    }
+    if (nParticles == 0) bbMin = bbMax = glm::vec3(0);
+
+    const glm::vec3 scale = QUANTUM / glm::max(bbMax - bbMin, glm::vec3(1e-9f));
+    for (uint i = 0; i < nParticles; i++) {
+        const glm::vec3 q = glm::round((pos[i] - bbMin) * scale);
+        for (int k = 0; k < 3; k++) {
+            quantized[3 * i + k] = (uint16_t)glm::clamp(q[k], 0.0f, QUANTUM);
+        }
+    }
+
+    const bool key = offsets.size() % KEY_INTERVAL == 0;
+
+    buffer.clear();
+    buffer.push_back(key ? KEY : DELTA);
+    buffer.resize(1 + 6 * sizeof(float));
+    std::memcpy(buffer.data() + 1, &bbMin, sizeof(glm::vec3));
+    std::memcpy(buffer.data() + 1 + sizeof(glm::vec3), &bbMax, sizeof(glm::vec3));
+
+    if (key) {
+        const size_t start = buffer.size();
+        buffer.resize(start + quantized.size() * sizeof(uint16_t));
+        std::memcpy(buffer.data() + start, quantized.data(), quantized.size() * sizeof(uint16_t));
+    } else {
+        for (size_t k = 0; k < quantized.size(); k++) {
+            const int32_t delta = (int32_t)quantized[k] - (int32_t)previous[k];
+            writeVarint(buffer, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+        }
+    }
+
+    offsets.push_back(file.tellp());
+    file.write(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    std::swap(previous, quantized);
+}
+
+Playback::Playback(const std::string &path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Could not open recording: " + path);
+
+    struct stat st;
+    if (fstat(fd, &st) == 0) size = st.st_size;
+    if (size >= sizeof(Header) + sizeof(Footer)) {
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) data = static_cast<const uint8_t *>(mapping);
+    }
+    close(fd); // the mapping stays valid
+
+    if (!data) throw std::runtime_error("Could not map recording: " + path);
+
+    Header header;
+    Footer footer;
+    std::memcpy(&header, data, sizeof(header));
+    std::memcpy(&footer, data + size - sizeof(footer), sizeof(footer));
+
+    // Written in this order, without overflow for any footer
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.keyInterval > 0 &&
+                 footer.indexOffset >= sizeof(Header) && footer.indexOffset <= size - sizeof(footer) &&
+                 footer.frameCount == (size - sizeof(footer) - footer.indexOffset) / sizeof(uint64_t) &&
+                 footer.indexOffset + footer.frameCount * sizeof(uint64_t) + sizeof(footer) == size;
+
+    if (valid) {
+        nParticles = header.nParticles;
+        sceneType = header.sceneType;
+        keyInterval = header.keyInterval;
+        frameCount = footer.frameCount;
+
+        offsets.resize(frameCount + 1);
+        std::memcpy(offsets.data(), data + footer.indexOffset, frameCount * sizeof(uint64_t));
+        offsets[frameCount] = footer.indexOffset;
+
+        // Frames one after the other before the index, key frames where expected, with their full size
+        const uint64_t keySize = FRAME_HEADER + 3 * sizeof(uint16_t) * (uint64_t)nParticles;
+        for (uint f = 0; f < frameCount && valid; f++) {
+            valid = offsets[f] >= sizeof(Header) && offsets[f] <= footer.indexOffset && offsets[f] + FRAME_HEADER <= offsets[f + 1];
+            if (!valid) break;
+
+            const uint8_t type = data[offsets[f]];
+            valid = f % keyInterval == 0 ? type == KEY && offsets[f + 1] - offsets[f] == keySize : type == DELTA;
+        }
+    }
+
+    if (!valid) {
+        munmap(const_cast<uint8_t *>(data), size);
+        throw std::runtime_error("Not a complete recording: " + path);
+    }
+
+    quantized.resize(3 * nParticles);
+    positions.resize(nParticles);
+}
+
+Playback::~Playback() {
+    if (data) munmap(const_cast<uint8_t *>(data), size);
+}
+
+const std::vector<glm::vec3> &Playback::getFrame(uint frame) {
+    if (frameCount == 0) return positions;
+    frame = std::min(frame, frameCount - 1);
+    if ((int)frame == decoded) return positions;
+
+    // Continue from the decoded frame when going forward inside the same key interval, else from its key frame
+    const uint key = frame - frame % keyInterval;
+    const uint first = decoded >= (int)key && decoded < (int)frame ? decoded + 1 : key;
+    for (uint f = first; f <= frame; f++) {
+        decode(f);
+    }
+
+    // Positions of the last decoded frame
+    glm::vec3 bbMin, bbMax;
+    const uint8_t *p = data + offsets[frame] + 1;
+    std::memcpy(&bbMin, p, sizeof(glm::vec3));
+    std::memcpy(&bbMax, p + sizeof(glm::vec3), sizeof(glm::vec3));
+
+    const glm::vec3 scale = glm::max(bbMax - bbMin, glm::vec3(1e-9f)) / QUANTUM;
+    for (uint i = 0; i < nParticles; i++) {
+        positions[i] = bbMin + scale * glm::vec3(quantized[3 * i], quantized[3 * i + 1], quantized[3 * i + 2]);
+    }
+
+    return positions;
+}
+
+void Playback::decode(uint frame) {
+    const uint8_t *p = data + offsets[frame];
+    const uint8_t *end = data + offsets[frame + 1];
+    const uint8_t type = *p;
+    p += FRAME_HEADER;
+
+    if (type == KEY) {
+        std::memcpy(quantized.data(), p, quantized.size() * sizeof(uint16_t));
+    } else {
+        for (size_t k = 0; k < quantized.size(); k++) {
+            const uint32_t zigzag = readVarint(p, end);
+            const int32_t delta = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+            quantized[k] = (uint16_t)((int32_t)quantized[k] + delta);
+        }
+    }
+
+    decoded = frame;
+}
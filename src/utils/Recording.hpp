@@ -0,0 +1,70 @@
+// Compact recording of the particle positions of a simulation, played back without the solver
+// To use:
+//    - Recorder: addFrame after each step; the file is complete once the recorder is destroyed
+//    - Playback: open the file, then getFrame for any frame, in any order
+// Each frame is quantized to 16 bits per axis inside its bounding box. Every KEY_INTERVAL frames, a key frame stores
+// the values; the other frames store the difference with the previous one as zigzag varints (one byte per axis for
+// small motions). The playback maps the file in memory and decodes from the closest key frame.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class Recorder {
+public:
+    static constexpr uint KEY_INTERVAL = 30;
+
+    Recorder(const std::string &path, uint nParticles, int sceneType);
+    ~Recorder();
+
+    Recorder(const Recorder &) = delete;
+    Recorder &operator=(const Recorder &) = delete;
+
+    void addFrame(const std::vector<glm::vec3> &pos);
+
+    uint getFrameCount() const { return offsets.size(); }
+    uint getParticleCount() const { return nParticles; }
+    bool isOpen() const { return file.is_open(); }
+
+private:
+    std::ofstream file;
+    uint nParticles;
+    std::vector<uint64_t> offsets;   // start of each frame in the file
+    std::vector<uint16_t> previous;  // quantized values of the last frame
+    std::vector<uint16_t> quantized; // quantized values of the current frame
+    std::vector<uint8_t> buffer;
+};
+
+class Playback {
+public:
+    // Throws std::runtime_error if the file is not a complete recording, or if its index does not match its frames
+    Playback(const std::string &path);
+    ~Playback();
+
+    Playback(const Playback &) = delete;
+    Playback &operator=(const Playback &) = delete;
+
+    const std::vector<glm::vec3> &getFrame(uint frame);
+
+    uint getFrameCount() const { return frameCount; }
+    uint getParticleCount() const { return nParticles; }
+    int getSceneType() const { return sceneType; }
+
+private:
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+
+    uint nParticles, frameCount, keyInterval;
+    int sceneType;
+    std::vector<uint64_t> offsets; // start of each frame, then of the index: frame f ends at offsets[f + 1]
+
+    int decoded = -1; // frame in quantized and positions
+    std::vector<uint16_t> quantized;
+    std::vector<glm::vec3> positions;
+
+    void decode(uint frame);
+};
@@ -0,0 +1,290 @@
+#include "SDF.hpp"
+#include "BVH.hpp"
+#include "Geometry.hpp"
+
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cmath>
+
+namespace {
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t meshHash;
+    float cellSize;
+    int32_t band;
+    int32_t res[3];
+    float origin[3];
+};
+
+// FNV-1a over the raw mesh data, to detect a stale cache
+uint64_t hashMesh(const std::vector<glm::vec3> &vertices, const std::vector<uint> &indices) {
+    uint64_t hash = 1469598103934665603ull;
+    auto add = [&](const void *data, size_t size) {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    add(vertices.data(), vertices.size() * sizeof(glm::vec3));
+    add(indices.data(), indices.size() * sizeof(uint));
+    return hash;
+}
+
+uint64_t edgeKey(uint a, uint b) {
+    return (uint64_t)std::min(a, b) << 32 | std::max(a, b);
+}
+
+} // namespace
+
+std::shared_ptr<SDF> SDF::createFromMesh(const std::vector<glm::vec3> &vertices, const std::vector<uint> &indices,
+                                         float cellSize, int band, const std::string &cachePath) {
+    std::shared_ptr<SDF> sdf(new SDF());
+    sdf->cellSize = cellSize;
+    sdf->band = band;
+    sdf->meshHash = hashMesh(vertices, indices);
+
+    if (!cachePath.empty() && sdf->load(cachePath)) return sdf;
+
+    sdf->build(vertices, indices);
+
+    if (!cachePath.empty()) sdf->save(cachePath);
+
+    return sdf;
+}
+
+void SDF::build(const std::vector<glm::vec3> &vertices, const std::vector<uint> &indices) {
+    // Grid around the mesh, with a margin so that its border is outside of the band
+    AABB bounds;
+    for (const glm::vec3 &v : vertices) bounds.expand(v);
+    bounds.inflate((band + 2) * cellSize);
+
+    origin = bounds.min;
+    res = glm::ivec3(glm::ceil((bounds.max - bounds.min) / cellSize)) + 1;
+    const uint nCells = res.x * res.y * res.z;
+
+    // Angle weighted pseudonormals of faces, edges and vertices give the sign of the distance
+    const uint nTris = indices.size() / 3;
+    std::vector<glm::vec3> faceNormals(nTris);
+    std::vector<glm::vec3> vertexNormals(vertices.size(), glm::vec3(0));
+    std::unordered_map<uint64_t, glm::vec3> edgeNormals;
+
+    for (uint t = 0; t < nTris; t++) {
+        const uint *tri = &indices[3 * t];
+        const glm::vec3 n = glm::normalize(glm::cross(vertices[tri[1]] - vertices[tri[0]], vertices[tri[2]] - vertices[tri[0]]));
+        faceNormals[t] = n;
+
+        for (int k = 0; k < 3; k++) {
+            const glm::vec3 &p = vertices[tri[k]];
+            const glm::vec3 e1 = glm::normalize(vertices[tri[(k + 1) % 3]] - p);
+            const glm::vec3 e2 = glm::normalize(vertices[tri[(k + 2) % 3]] - p);
+            vertexNormals[tri[k]] += glm::acos(glm::clamp(glm::dot(e1, e2), -1.0f, 1.0f)) * n;
+            edgeNormals[edgeKey(tri[k], tri[(k + 1) % 3])] += n;
+        }
+    }
+
+    BVH bvh(indices, 3, vertices);
+
+    // Exact distances in the band
+    const float bandDist = band * cellSize;
+    std::vector<char> known(nCells, 0);
+    values.assign(nCells, FLT_MAX);
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int z = 0; z < res.z; z++) {
+        for (int y = 0; y < res.y; y++) {
+            for (int x = 0; x < res.x; x++) {
+                const glm::vec3 p = origin + glm::vec3(x, y, z) * cellSize;
+                AABB box(p, p);
+                box.inflate(bandDist);
+
+                float best = FLT_MAX;
+                uint bestTri = 0;
+                glm::vec3 bestBary, bestPoint;
+
+                bvh.query(box, [&](uint t) {
+                    const uint *tri = &indices[3 * t];
+                    glm::vec3 bary;
+                    const glm::vec3 q = utils::closestPointTriangle(p, vertices[tri[0]], vertices[tri[1]], vertices[tri[2]], bary);
+                    const float d2 = glm::dot(p - q, p - q);
+                    if (d2 < best) {
+                        best = d2;
+                        bestTri = t;
+                        bestBary = bary;
+                        bestPoint = q;
+                    }
+                });
+
+                // Further triangles may be closer than the ones found outside of the band
+                if (best > bandDist * bandDist) continue;
+
+                // Pseudonormal of the closest feature
+                const uint *tri = &indices[3 * bestTri];
+                const int zeros = (bestBary.x <= 0) + (bestBary.y <= 0) + (bestBary.z <= 0);
+                glm::vec3 n = faceNormals[bestTri];
+                for (int k = 0; k < 3; k++) {
+                    if (zeros == 2 && bestBary[k] > 0) n = vertexNormals[tri[k]];
+                    if (zeros == 1 && bestBary[k] <= 0) n = edgeNormals.at(edgeKey(tri[(k + 1) % 3], tri[(k + 2) % 3]));
+                }
+
+                const uint i = index(x, y, z);
+                const float d = std::sqrt(best);
+                values[i] = glm::dot(p - bestPoint, n) >= 0 ? d : -d;
+                known[i] = 1;
+            }
+        }
+    }
+
+    // Flood fill from the border of the grid: cells reached without crossing the band are outside
+    std::vector<char> outside(nCells, 0);
+    std::vector<glm::ivec3> stack;
+    for (int z = 0; z < res.z; z++) {
+        for (int y = 0; y < res.y; y++) {
+            for (int x = 0; x < res.x; x++) {
+                if (x == 0 || y == 0 || z == 0 || x == res.x - 1 || y == res.y - 1 || z == res.z - 1) {
+                    stack.emplace_back(x, y, z);
+                }
+            }
+        }
+    }
+
+    while (!stack.empty()) {
+        const glm::ivec3 c = stack.back();
+        stack.pop_back();
+        if (glm::any(glm::lessThan(c, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(c, res))) continue;
+
+        const uint i = index(c.x, c.y, c.z);
+        if (known[i] || outside[i]) continue;
+        outside[i] = 1;
+
+        stack.emplace_back(c.x + 1, c.y, c.z);
+        stack.emplace_back(c.x - 1, c.y, c.z);
+        stack.emplace_back(c.x, c.y + 1, c.z);
+        stack.emplace_back(c.x, c.y - 1, c.z);
+        stack.emplace_back(c.x, c.y, c.z + 1);
+        stack.emplace_back(c.x, c.y, c.z - 1);
+    }
+
+    // Approximate distances outside of the band with two chamfer sweeps on the magnitudes
+    std::vector<float> dist(nCells);
+    for (uint i = 0; i < nCells; i++) {
+        dist[i] = known[i] ? glm::abs(values[i]) : FLT_MAX;
+    }
+
+    auto sweep = [&](int dir) {
+        const int zStart = dir > 0 ? 0 : res.z - 1;
+        const int yStart = dir > 0 ? 0 : res.y - 1;
+        const int xStart = dir > 0 ? 0 : res.x - 1;
+
+        for (int z = zStart; z >= 0 && z < res.z; z += dir) {
+            for (int y = yStart; y >= 0 && y < res.y; y += dir) {
+                for (int x = xStart; x >= 0 && x < res.x; x += dir) {
+                    const uint i = index(x, y, z);
+                    if (known[i]) continue;
+
+                    // Neighbours already visited by this sweep
+                    for (int dz = -1; dz <= 0; dz++) {
+                        for (int dy = -1; dy <= 1; dy++) {
+                            for (int dx = -1; dx <= 1; dx++) {
+                                if (dz == 0 && (dy > 0 || (dy == 0 && dx >= 0))) continue;
+
+                                const int nx = x + dir * dx, ny = y + dir * dy, nz = z + dir * dz;
+                                if (nx < 0 || ny < 0 || nz < 0 || nx >= res.x || ny >= res.y || nz >= res.z) continue;
+
+                                const float d = dist[index(nx, ny, nz)];
+                                if (d == FLT_MAX) continue;
+                                dist[i] = glm::min(dist[i], d + cellSize * std::sqrt((float)(dx * dx + dy * dy + dz * dz)));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+    sweep(1);
+    sweep(-1);
+
+    for (uint i = 0; i < nCells; i++) {
+        if (!known[i]) values[i] = outside[i] ? dist[i] : -dist[i];
+    }
+}
+
+float SDF::sample(const glm::vec3 &p, glm::vec3 &grad) const {
+    const glm::vec3 g = (p - origin) / cellSize;
+    if (g.x < 0 || g.y < 0 || g.z < 0 || g.x > res.x - 1 || g.y > res.y - 1 || g.z > res.z - 1) {
+        // The mesh is at least (band + 2) cells inside of the grid
+        const glm::vec3 q = glm::clamp(p, origin, origin + glm::vec3(res - 1) * cellSize);
+        grad = glm::normalize(p - q);
+        return glm::length(p - q) + (band + 2) * cellSize;
+    }
+
+    const glm::ivec3 c = glm::min(glm::ivec3(g), res - 2);
+    const glm::vec3 f = g - glm::vec3(c);
+
+    const float v000 = values[index(c.x, c.y, c.z)];
+    const float v100 = values[index(c.x + 1, c.y, c.z)];
+    const float v010 = values[index(c.x, c.y + 1, c.z)];
+    const float v110 = values[index(c.x + 1, c.y + 1, c.z)];
+    const float v001 = values[index(c.x, c.y, c.z + 1)];
+    const float v101 = values[index(c.x + 1, c.y, c.z + 1)];
+    const float v011 = values[index(c.x, c.y + 1, c.z + 1)];
+    const float v111 = values[index(c.x + 1, c.y + 1, c.z + 1)];
+
+    // Interpolate along x, then y, then z
+    const float v00 = glm::mix(v000, v100, f.x);
+    const float v10 = glm::mix(v010, v110, f.x);
+    const float v01 = glm::mix(v001, v101, f.x);
+    const float v11 = glm::mix(v011, v111, f.x);
+    const float v0 = glm::mix(v00, v10, f.y);
+    const float v1 = glm::mix(v01, v11, f.y);
+
+    grad.x = glm::mix(glm::mix(v100 - v000, v110 - v010, f.y), glm::mix(v101 - v001, v111 - v011, f.y), f.z);
+    grad.y = glm::mix(v10 - v00, v11 - v01, f.z);
+    grad.z = v1 - v0;
+    grad /= cellSize;
+
+    const float len = glm::length(grad);
+    if (len > 1e-6f) grad /= len;
+
+    return glm::mix(v0, v1, f.z);
+}
+
+bool SDF::load(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    CacheHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) return false;
+
+    if (std::memcmp(header.magic, "SDF", 4) != 0 || header.version != VERSION || header.meshHash != meshHash ||
+        header.cellSize != cellSize || header.band != band) {
+        return false;
+    }
+
+    res = glm::ivec3(header.res[0], header.res[1], header.res[2]);
+    origin = glm::vec3(header.origin[0], header.origin[1], header.origin[2]);
+
+    values.resize(res.x * res.y * res.z);
+    return (bool)file.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(float));
+}
+
+void SDF::save(const std::string &path) const {
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Could not write SDF cache: " << path << std::endl;
+        return;
+    }
+
+    CacheHeader header = {{'S', 'D', 'F', '\0'}, VERSION, meshHash, cellSize, band,
+                          {res.x, res.y, res.z}, {origin.x, origin.y, origin.z}};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(float));
+}
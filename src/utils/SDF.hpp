@@ -0,0 +1,45 @@
+// Signed distance field of a static triangle mesh on a regular grid, negative inside
+// To use:
+//    - createFromMesh voxelizes the mesh once (exact distances in a narrow band around the surface, approximate further away)
+//    - If a cache path is given, the grid is stored there and reloaded as long as the mesh and parameters did not change
+//    - sample gives the distance and its gradient at any point by trilinear interpolation
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class SDF {
+public:
+    // cellSize: size of a voxel. band: width in voxels of the exact band
+    static std::shared_ptr<SDF> createFromMesh(const std::vector<glm::vec3> &vertices, const std::vector<uint> &indices,
+                                               float cellSize, int band = 3, const std::string &cachePath = "");
+
+    // Distance to the surface at p and its gradient. Outside of the grid, only a lower bound of the distance.
+    float sample(const glm::vec3 &p, glm::vec3 &grad) const;
+
+    const glm::vec3 &getOrigin() const { return origin; }
+    const glm::ivec3 &getResolution() const { return res; }
+    float getCellSize() const { return cellSize; }
+
+private:
+    static constexpr uint32_t VERSION = 1;
+
+    glm::vec3 origin;
+    glm::ivec3 res;
+    float cellSize;
+    int band;
+    uint64_t meshHash;
+    std::vector<float> values; // x fastest, then y, then z
+
+    SDF() {}
+
+    uint index(int x, int y, int z) const { return (z * res.y + y) * res.x + x; }
+
+    void build(const std::vector<glm::vec3> &vertices, const std::vector<uint> &indices);
+    bool load(const std::string &path);
+    void save(const std::string &path) const;
+};
@@ -42,7 +42,8 @@ public:
 
     void clear() { grid.clear(); }
     void addParticle(const glm::vec3 &pos, uint index) {
-        Coordinates3D coord(pos / h);
-        grid[coord].push_back(index);
+        grid[getCell(pos)].push_back(index);
     }
+
+    Coordinates3D getCell(const glm::vec3 &pos) const { return Coordinates3D(pos / h); }
 };
\ No newline at end of file